@@ -0,0 +1,132 @@
+//AnytimeRobot.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+// What an anytime robot does with its turn. Values match the arena's
+// TurnAction.
+struct AnytimeAction {
+    enum Kind : uint8_t { None = 0, Shot = 1, Move = 2 };
+    Kind kind = None;
+    int a = 0, b = 0;          // shot row/col or move dir/dist
+
+    static AnytimeAction shot(int row, int col) { return { Shot, row, col }; }
+    static AnytimeAction move(int dir, int dist) { return { Move, dir, dist }; }
+};
+
+// The coroutine AnytimeRobot::think returns. It starts suspended; the
+// scheduler resumes it and destroys it when the game ends.
+class ThinkTask {
+public:
+    struct promise_type {
+        ThinkTask get_return_object() {
+            return ThinkTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }    // like pool tasks, think() must not throw
+    };
+
+    ThinkTask() = default;
+    explicit ThinkTask(std::coroutine_handle<promise_type> h) : m_handle(h) {}
+    ThinkTask(ThinkTask&& o) noexcept : m_handle(std::exchange(o.m_handle, {})) {}
+    ThinkTask& operator=(ThinkTask&& o) noexcept {
+        if (this != &o) {
+            reset();
+            m_handle = std::exchange(o.m_handle, {});
+        }
+        return *this;
+    }
+    ~ThinkTask() { reset(); }
+
+    explicit operator bool() const { return static_cast<bool>(m_handle); }
+    bool done() const { return m_handle.done(); }
+    void resume() { m_handle.resume(); }
+    void reset() {
+        if (m_handle) m_handle.destroy();
+        m_handle = {};
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+// The robot's side of the scheduler, handed to think().
+class AnytimeTurns {
+public:
+    // Turns started so far, the current one included.
+    int turn() const { return m_turn; }
+    // True while the arena waits on this turn's action, false while
+    // thinking in the background between turns.
+    bool onTurn() const { return m_onTurn; }
+
+    // The best action so far this turn. When the turn's time is up the
+    // arena plays whatever was committed last; every turn starts at None,
+    // and commits made between turns are dropped.
+    void commit(const AnytimeAction& action) { m_committed = action; }
+
+    // co_await turns.next(): done with this turn; resumes when the next
+    // one starts.
+    auto next() {
+        struct Awaiter {
+            AnytimeTurns& turns;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<>) noexcept { turns.m_waiting = true; }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ *this };
+    }
+
+    // co_await turns.checkpoint(): somewhere thinking may stop. Suspends
+    // only once the current slice is used up or the arena needs the robot,
+    // and resumes in a later slice, possibly in a later turn (see turn()).
+    auto checkpoint() {
+        struct Awaiter {
+            AnytimeTurns& turns;
+            bool await_ready() const noexcept { return !turns.sliceOver(); }
+            void await_suspend(std::coroutine_handle<>) noexcept {}
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ *this };
+    }
+
+private:
+    friend class AnytimeScheduler;
+    bool sliceOver() const {
+        return m_stop.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= m_sliceEnd;
+    }
+
+    int m_turn = 0;
+    bool m_onTurn = false;
+    bool m_waiting = false;                // suspended in next() rather than checkpoint()
+    std::atomic<bool> m_stop{false};       // the arena wants the robot back now
+    std::chrono::steady_clock::time_point m_sliceEnd{};
+    AnytimeAction m_committed;
+};
+
+// Opt-in turn model for robots with expensive decisions (see
+// ResettableRobot for the pattern). The arena still calls
+// get_radar_direction and process_radar_results, then, instead of
+// get_shot_location and get_move_direction, runs think() for up to the
+// turn budget and plays the action committed last. think() is one
+// coroutine for the whole game. It co_awaits turns.next() once it has
+// settled on a turn's action, and turns.checkpoint() at points where it
+// can stop mid-way, so planning can carry on into the next turn.
+//
+// With a thread pool set, a robot still thinking when its turn ends keeps
+// going in background slices between turns. Background slices run
+// concurrently with the arena, so they must not call RobotBase methods
+// (the arena moves and damages the robot meanwhile). They may use the
+// robot's own members: the robot is paused while the arena calls it.
+class AnytimeRobot {
+public:
+    virtual ThinkTask think(AnytimeTurns& turns) = 0;
+
+protected:
+    ~AnytimeRobot() = default;
+};
@@ -0,0 +1,117 @@
+//AnytimeScheduler.cpp
+#include "AnytimeScheduler.h"
+#include "ThreadPool.h"
+
+AnytimeScheduler::AnytimeScheduler(std::chrono::microseconds slice)
+    : m_queue(std::make_shared<RunQueue>())
+{
+    m_queue->slice = slice;
+}
+
+AnytimeScheduler::~AnytimeScheduler() { clear(); }
+
+void AnytimeScheduler::setPool(ThreadPool* pool) {
+    clear();
+    // tasks still in the old pool keep the old queue
+    auto q = std::make_shared<RunQueue>();
+    q->pool = pool;
+    q->slice = m_queue->slice;
+    m_queue = std::move(q);
+}
+
+void AnytimeScheduler::resize(size_t robots) {
+    while (m_slots.size() < robots) m_slots.push_back(std::make_shared<Slot>());
+}
+
+void AnytimeScheduler::pause(int i) {
+    Slot& s = *m_slots[i];
+    std::unique_lock lock(s.m);
+    if (s.state == State::Queued) {
+        s.state = State::Parked;            // its queued task will find that and do nothing
+    } else if (s.state == State::Running) {
+        s.turns.m_stop = true;
+        s.cv.wait(lock, [&] { return s.state != State::Running; });
+        s.turns.m_stop = false;
+    }
+}
+
+AnytimeScheduler::State AnytimeScheduler::runSlice(Slot& s, std::chrono::steady_clock::time_point end) {
+    s.turns.m_sliceEnd = end;
+    s.turns.m_waiting = false;
+    s.task.resume();
+    if (s.task.done()) return State::Done;
+    return s.turns.m_waiting ? State::Waiting : State::Parked;
+}
+
+AnytimeAction AnytimeScheduler::turn(int i, AnytimeRobot& robot, std::chrono::microseconds budget) {
+    const auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<Slot> slot = m_slots[i];
+    Slot& s = *slot;
+    {
+        std::lock_guard lock(s.m);
+        if (s.state == State::Done) return {};
+        s.state = State::Running;
+    }
+    if (!s.task) s.task = robot.think(s.turns);
+    ++s.turns.m_turn;
+    s.turns.m_onTurn = true;
+    s.turns.m_committed = {};
+
+    State next = runSlice(s, start + budget);
+    AnytimeAction action = s.turns.m_committed;
+    s.turns.m_onTurn = false;
+
+    bool more = next == State::Parked && m_queue->pool;
+    {
+        std::lock_guard lock(s.m);
+        s.state = more ? State::Queued : next;
+    }
+    if (more) enqueue(m_queue, slot);
+    return action;
+}
+
+void AnytimeScheduler::enqueue(const std::shared_ptr<RunQueue>& q, std::shared_ptr<Slot> s) {
+    {
+        std::lock_guard lock(q->m);
+        q->slots.push_back(std::move(s));
+    }
+    q->pool->submit([q] { runQueued(q); });
+}
+
+void AnytimeScheduler::runQueued(const std::shared_ptr<RunQueue>& q) {
+    std::shared_ptr<Slot> slot;
+    {
+        std::lock_guard lock(q->m);
+        if (q->slots.empty()) return;
+        slot = std::move(q->slots.front());
+        q->slots.pop_front();
+    }
+    Slot& s = *slot;
+    {
+        std::lock_guard lock(s.m);
+        if (s.state != State::Queued) return;        // paused meanwhile
+        s.state = State::Running;
+    }
+    State next = runSlice(s, std::chrono::steady_clock::now() + q->slice);
+    bool more;
+    {
+        // decided under the lock, so a pause() waiting on this is never missed
+        std::lock_guard lock(s.m);
+        more = next == State::Parked && !s.turns.m_stop;
+        s.state = more ? State::Queued : next;
+        s.turns.m_committed = {};
+    }
+    s.cv.notify_all();
+    if (more) enqueue(q, std::move(slot));
+}
+
+void AnytimeScheduler::clear() {
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        Slot& s = *m_slots[i];
+        if (!s.task && s.state == State::Idle) continue;    // never thought
+        pause(static_cast<int>(i));
+        s.task.reset();
+        // queued tasks may still hold the old slot; they find it parked
+        m_slots[i] = std::make_shared<Slot>();
+    }
+}
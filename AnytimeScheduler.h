@@ -0,0 +1,73 @@
+//AnytimeScheduler.h
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "AnytimeRobot.h"
+
+class ThreadPool;
+
+// Runs the arena's AnytimeRobot::think coroutines, one slot per robot
+// index. A robot's turn is a slice run on whichever thread decides for
+// it. The slice ends when think() reaches next() or the turn budget runs
+// out, and the turn's action is whatever was committed by then. With a
+// pool, a robot that ends its turn still thinking goes on in background
+// slices on the pool until pause() stops it. Robots waiting for a slice
+// queue up here, first in first out, and each pool task runs the oldest
+// one for a slice. Slices are short, so many robots share a few workers
+// and pause() waits at most one slice.
+class AnytimeScheduler {
+public:
+    explicit AnytimeScheduler(std::chrono::microseconds slice = std::chrono::microseconds(500));
+    ~AnytimeScheduler();
+    AnytimeScheduler(const AnytimeScheduler&) = delete;
+    AnytimeScheduler& operator=(const AnytimeScheduler&) = delete;
+
+    // Background thinking runs here; without a pool there is none. Stops
+    // everything, like clear().
+    void setPool(ThreadPool* pool);
+    // Makes room for robot indices [0, robots).
+    void resize(size_t robots);
+
+    // Stops robot i thinking in the background and waits until it has.
+    // Call before anything else touches the robot.
+    void pause(int i);
+    // Robot i's turn, after pause(i): up to `budget` of think(), which is
+    // started on the robot's first turn. Returns the committed action.
+    AnytimeAction turn(int i, AnytimeRobot& robot, std::chrono::microseconds budget);
+    // Stops and destroys every coroutine; call before the robots are
+    // reset or deleted.
+    void clear();
+
+private:
+    enum class State { Idle, Queued, Running, Parked, Waiting, Done };
+    struct Slot {
+        std::mutex m;
+        std::condition_variable cv;
+        State state = State::Idle;
+        ThinkTask task;
+        AnytimeTurns turns;
+    };
+
+    // Resumes the slot's coroutine until `end`; returns the state it
+    // stopped in. The caller holds the slot as Running.
+    static State runSlice(Slot& s, std::chrono::steady_clock::time_point end);
+    // Slots waiting for a background slice. Shared with the pool tasks,
+    // which may outlive a clear() or the scheduler.
+    struct RunQueue {
+        std::mutex m;
+        std::deque<std::shared_ptr<Slot>> slots;
+        ThreadPool* pool = nullptr;
+        std::chrono::microseconds slice{};
+    };
+    static void enqueue(const std::shared_ptr<RunQueue>& q, std::shared_ptr<Slot> s);
+    // One background slice for the oldest queued slot.
+    static void runQueued(const std::shared_ptr<RunQueue>& q);
+
+    std::vector<std::shared_ptr<Slot>> m_slots;
+    std::shared_ptr<RunQueue> m_queue;
+};
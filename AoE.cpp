@@ -0,0 +1,75 @@
+//AoE.cpp
+#include "AoE.h"
+#include "DamageModel.h"
+#include <algorithm>
+
+AoeShape AoE::blast(int radius) {
+    AoeShape s;
+    for (int dr = -radius; dr <= radius; ++dr)
+        for (int dc = -radius; dc <= radius; ++dc)
+            s.set(dr, dc);
+    return s;
+}
+
+AoeShape AoE::ring() {
+    AoeShape s = blast(1);
+    s.clear(0, 0);
+    return s;
+}
+
+AoeShape AoE::cone(int dr, int dc, int range, int halfWidth) {
+    AoeShape s;
+    for (int step = 1; step <= range; ++step) {
+        int cr = dr * step, cc = dc * step;
+        for (int off = -halfWidth; off <= halfWidth; ++off) {
+            if (dr == 0)      s.set(cr + off, cc);          // widen across a row shot
+            else if (dc == 0) s.set(cr, cc + off);          // widen across a column shot
+            else              s.set(cr + off, cc + off);
+        }
+    }
+    s.clear(0, 0);
+    return s;
+}
+
+const AoeShape& AoE::flameCone(int dr, int dc) {
+    // indexed [dr+1][dc+1]
+    static const auto cones = [] {
+        std::array<std::array<AoeShape, 3>, 3> t{};
+        for (int r = -1; r <= 1; ++r)
+            for (int c = -1; c <= 1; ++c)
+                if (r || c) t[r + 1][c + 1] = cone(r, c, DM::FlameRange, DM::FlameHalfWidth);
+        return t;
+    }();
+    return cones[dr + 1][dc + 1];
+}
+
+const AoeShape& AoE::hammer() {
+    static const AoeShape shape = ring();
+    return shape;
+}
+
+const AoeShape& AoE::grenadeBlast() {
+    static const AoeShape shape = blast(DM::GrenadeBlastRadius);
+    return shape;
+}
+
+void AoE::gather(const std::vector<int>& occupancy, int rows, int cols,
+                 const AoeShape& shape, int r0, int c0, std::vector<int>& out) {
+    const int R = AoeShape::RADIUS;
+    int rLo = std::max(0, r0 - R), rHi = std::min(rows - 1, r0 + R);
+    int cLo = std::max(0, c0 - R), cHi = std::min(cols - 1, c0 + R);
+    if (rLo > rHi || cLo > cHi) return;
+
+    // columns outside the board are masked off once, up front
+    unsigned clip = ((1u << (cHi - cLo + 1)) - 1u) << (cLo - (c0 - R));
+    for (int r = rLo; r <= rHi; ++r) {
+        unsigned bits = shape.rows[r - r0 + R] & clip;
+        size_t rowBase = static_cast<size_t>(r) * cols;
+        while (bits) {
+            int b = __builtin_ctz(bits);
+            bits &= bits - 1;
+            int idx = occupancy[rowBase + (c0 - R + b)];
+            if (idx >= 0) out.push_back(idx);
+        }
+    }
+}
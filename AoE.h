@@ -0,0 +1,52 @@
+//AoE.h
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Area-of-effect footprints as bitmasks over a small window centred on the
+// weapon's origin: bit (c + RADIUS) of row (r + RADIUS) covers offset (r, c).
+// A cell is either in the footprint or not, so a robot is hit at most once
+// per attack no matter how the shape was drawn.
+struct AoeShape {
+    static constexpr int RADIUS = 7;
+    static constexpr int WIDTH  = 2 * RADIUS + 1;
+    static_assert(WIDTH <= 16, "rows are 16-bit masks");
+
+    std::array<uint16_t, WIDTH> rows{};
+
+    void set(int dr, int dc) {
+        if (dr < -RADIUS || dr > RADIUS || dc < -RADIUS || dc > RADIUS) return;
+        rows[dr + RADIUS] |= static_cast<uint16_t>(1u << (dc + RADIUS));
+    }
+    void clear(int dr, int dc) {
+        if (dr < -RADIUS || dr > RADIUS || dc < -RADIUS || dc > RADIUS) return;
+        rows[dr + RADIUS] &= static_cast<uint16_t>(~(1u << (dc + RADIUS)));
+    }
+    bool test(int dr, int dc) const {
+        if (dr < -RADIUS || dr > RADIUS || dc < -RADIUS || dc > RADIUS) return false;
+        return rows[dr + RADIUS] >> (dc + RADIUS) & 1u;
+    }
+};
+
+namespace AoE {
+    // Square of cells within `radius` of the origin, origin included (grenade).
+    AoeShape blast(int radius);
+    // The 8 cells around the origin (hammer).
+    AoeShape ring();
+    // The flamethrower's cone in unit direction (dr, dc): `range` steps out,
+    // `halfWidth` cells either side of the centre line. Never covers the origin.
+    AoeShape cone(int dr, int dc, int range, int halfWidth);
+
+    // The weapons' footprints at DamageModel's sizes, built on first use.
+    // Arena and WorldState both read them, so the two can't disagree.
+    const AoeShape& flameCone(int dr, int dc);     // unit direction, not (0, 0)
+    const AoeShape& hammer();
+    const AoeShape& grenadeBlast();
+
+    // Appends the index of every robot under `shape` placed at (r0, c0),
+    // row-major. `occupancy` is rows*cols cell -> robot index or -1;
+    // the window is clipped to the board.
+    void gather(const std::vector<int>& occupancy, int rows, int cols,
+                const AoeShape& shape, int r0, int c0, std::vector<int>& out);
+}
@@ -1,47 +1,106 @@
 //Arena.cpp
 #include "Arena.h"
 #include "DamageModel.h"
+#include "TournamentStats.h"
+#include "Replay.h"
+#include "LiveViewer.h"
+#include "ThreadPool.h"
+#include "RobotPool.h"
+#include "Stalemate.h"
+#include "RobotKit.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
 #include <random>
 #include <iomanip>
-#include <thread>
-#include <chrono>
 #include <fstream>
+#include <limits>
 
 
 extern const std::pair<int,int> directions[9];
 
-Arena::Arena(int rows,int cols)
-    :m_board(rows,cols)
+namespace {
+    ArenaOptions sized(int rows, int cols) {
+        ArenaOptions o;
+        o.rows = rows;
+        o.cols = cols;
+        return o;
+    }
+
+    uint64_t pickSeed(uint64_t seed) {
+        return seed ? seed : std::random_device{}();
+    }
+
+    const char ID_POOL[] = {'!','@','#','$','%','^','&','*'};
+    constexpr int ID_POOL_SIZE = static_cast<int>(sizeof(ID_POOL) / sizeof(ID_POOL[0]));
+}
+
+template <class BoardT>
+ArenaT<BoardT>::ArenaT(int rows,int cols)
+    :ArenaT(sized(rows,cols))
 {
-    //m_board.seedDefaultFeatures();
-    seedRandomTerrain();
 }
-Arena::~Arena(){ for(auto& re : m_robots) delete re.bot;}
 
-namespace {
-    const char ID_POOL[] = {'!','@','#','$','%','^','&','*'};
-    int id_pool_index = 0;
+template <class BoardT>
+ArenaT<BoardT>::ArenaT(const ArenaOptions& options)
+    :m_options(options),
+     m_rng(static_cast<std::mt19937::result_type>(pickSeed(options.seed))),
+     m_board(options.rows,options.cols)
+{
+    m_lines.reset(options.rows, options.cols);
+    m_corpses.reset(options.rows, options.cols);
+    m_occupancy.assign(static_cast<size_t>(options.rows) * options.cols, -1);
+    seedRandomTerrain();
+}
+template <class BoardT>
+ArenaT<BoardT>::~ArenaT(){ releaseRobots(); }
 
-    char nextIdGlyph() {
-        char ch = ID_POOL[id_pool_index];
-        id_pool_index = (id_pool_index + 1) % (int)(sizeof(ID_POOL)/sizeof(ID_POOL[0]));
-        return ch;
+template <class BoardT>
+void ArenaT<BoardT>::releaseRobots(){
+    m_anytime.clear();
+    for (auto& re : m_robots) {
+        if (m_robotPool) m_robotPool->release(re.bot);
+        else delete re.bot;
     }
+    m_robots.clear();
+}
+
+// Same as destroying this arena and building a new one with the same
+// options and the given seed, minus the reallocation: the robots go back
+// to the pool (or are deleted) and every per-game buffer keeps its capacity.
+template <class BoardT>
+void ArenaT<BoardT>::reset(uint64_t seed){
+    releaseRobots();
+    std::pmr::vector<RobotEntry>(&m_gameMemory).swap(m_robots);
+    m_gameBuffer.release();
+    m_gameMemory.resetCounts();
+    m_heapSide.resetCounts();
+    m_options.seed = seed;
+    m_rng.seed(static_cast<std::mt19937::result_type>(pickSeed(seed)));
+    m_board.clear();
+    m_lines.reset(m_board.rows(), m_board.cols());
+    m_corpses.reset(m_board.rows(), m_board.cols());
+    std::fill(m_occupancy.begin(), m_occupancy.end(), -1);
+    m_spawnsValid = false;
+    m_nextIdGlyph = 0;
+    seedRandomTerrain();
 }
 
-void Arena::addRobot(RobotBase* robot,
+template <class BoardT>
+void ArenaT<BoardT>::addRobot(RobotBase* robot,
                      const std::string& name,
                      char weaponGlyph,
                      int row,
                      int col) {
-    RobotEntry r;
+    RobotEntry& r = m_robots.emplace_back();
     r.bot         = robot;
+    r.spanRadar   = dynamic_cast<SpanRadarRobot*>(robot);
+    r.anytime     = dynamic_cast<AnytimeRobot*>(robot);
+    r.forfeit     = dynamic_cast<ForfeitingRobot*>(robot);
     r.name        = name;
     r.weaponGlyph = weaponGlyph;
-    r.idGlyph     = nextIdGlyph();
+    r.idGlyph     = ID_POOL[m_nextIdGlyph];
+    m_nextIdGlyph = (m_nextIdGlyph + 1) % ID_POOL_SIZE;
     r.r           = row;
     r.c           = col;
     r.alive       = true;
@@ -51,21 +110,25 @@ void Arena::addRobot(RobotBase* robot,
     r.bot->m_name      = name;
     r.bot->m_character = weaponGlyph;
 
-    m_robots.push_back(r);
+    m_lines.insert(static_cast<int>(m_robots.size()) - 1, row, col);
+    m_occupancy[m_board.index(row, col)] = static_cast<int>(m_robots.size()) - 1;
+    if (m_spawnsValid) m_spawns.claim(row, col);
+    m_anytime.resize(m_robots.size());
 }
 
 
-int Arena::aliveCount()const{
+template <class BoardT>
+int ArenaT<BoardT>::aliveCount()const{
     int n=0; for(auto& r: m_robots)if(r.alive && r.bot->get_health()>0) n++;
     return n;}
 
 
-bool Arena::occupied(int r,int c, int* idx_out) const{
-    for(size_t i=0;i<m_robots.size();++i){
-        const auto& e=m_robots[i];
-        if(e.alive && e.r==r && e.c==c){ if(idx_out) *idx_out=(int)i; return true;}}return false;}
+template <class BoardT>
+bool ArenaT<BoardT>::occupied(int r,int c, int* idx_out) const{
+    return occupiedAlive(r, c, idx_out);}
 
-char Arena::boardCharAt(int r, int c) const {
+template <class BoardT>
+char ArenaT<BoardT>::boardCharAt(int r, int c) const {
     int idx = -1;
     if (occupiedAny(r, c, &idx) && idx >= 0) {
         const auto &e = m_robots[idx];
@@ -84,7 +147,8 @@ char Arena::boardCharAt(int r, int c) const {
         default:          return '.';
     }
 }
-void Arena::printBoard(std::ostream& os) const {
+template <class BoardT>
+void ArenaT<BoardT>::printBoard(std::ostream& os) const {
     os << "\n\n\n    ";
     for (int c = 0; c < m_board.cols(); ++c) {
         os << std::setw(3) << c << " "; 
@@ -94,65 +158,127 @@ void Arena::printBoard(std::ostream& os) const {
     for (int r = 0; r < m_board.rows(); ++r) {
         os << std::setw(2) << r << "  ";
         for (int c = 0; c < m_board.cols(); ++c) {
-            os << boardCellString(r,c) << ' ' << ' ';             
+            char cell[2];
+            boardCellChars(r, c, cell);
+            os.write(cell, 2) << ' ' << ' ';
         }
         os << '\n' << '\n' << ' ';
     }
 }
 
-bool Arena::occupiedAlive(int r,int c, int* idx_out) const {
-    for (size_t i=0;i<m_robots.size();++i){
-        const auto& e=m_robots[i];
-        if (e.alive && e.r==r && e.c==c){
-            if (idx_out) *idx_out=(int)i;
-            return true;}}
-    return false;}
-bool Arena::occupiedAny(int r,int c,int* idx_out)const{
-    for (size_t i=0;i<m_robots.size();++i){
-        const auto& e=m_robots[i];
-        if (e.r==r && e.c==c){
-            if (idx_out) *idx_out=(int)i;
-            return true;}}
-    return false;}
+template <class BoardT>
+void ArenaT<BoardT>::snapshotWorld(WorldState& world, uint64_t seed) const {
+    world.reset(m_board.rows(), m_board.cols(), seed);
+    for (int r = 0; r < m_board.rows(); ++r)
+        for (int c = 0; c < m_board.cols(); ++c)
+            world.setTile(r, c, m_board.get(r, c));
+    for (const auto& re : m_robots) {
+        RobotBase& b = *re.bot;
+        world.addRobot(re.r, re.c, b.get_health(), b.get_armor(), b.get_move_speed(),
+                       b.get_grenades(), b.get_weapon(),
+                       re.alive && b.get_health() > 0, re.trappedInPit);
+    }
+}
 
-std::vector<RadarObj> Arena::scanDirection(const RobotEntry& re,int dir) const {
-    std::vector<RadarObj> out;
-    if (dir < 1 || dir > 8) return out;
+template <class BoardT>
+void ArenaT<BoardT>::captureFrame(ArenaFrame& f, int round) const {
+    f.rows  = m_board.rows();
+    f.cols  = m_board.cols();
+    f.round = round;
+
+    f.cells.resize(2 * static_cast<size_t>(f.rows) * f.cols);
+    char* cell = f.cells.data();
+    for (int r = 0; r < f.rows; ++r) {
+        for (int c = 0; c < f.cols; ++c, cell += 2) {
+            cell[0] = ' ';
+            cell[1] = tileGlyph(m_board.get(r, c));
+        }
+    }
+
+    f.robots.resize(m_robots.size());
+    for (size_t i = 0; i < m_robots.size(); ++i) {
+        const auto& e = m_robots[i];
+        auto& fr = f.robots[i];
+        bool alive = e.alive && e.bot->get_health() > 0;
+
+        fr.name.assign(e.name);
+        fr.glyph   = e.weaponGlyph;
+        fr.idGlyph = e.idGlyph;
+        fr.weapon  = e.bot->get_weapon();
+        fr.health  = e.bot->get_health();
+        fr.armor   = e.bot->get_armor();
+        fr.move    = e.bot->get_move_speed();
+        fr.r       = e.r;
+        fr.c       = e.c;
+        fr.alive   = e.alive;
+
+        if (m_board.inBounds(e.r, e.c)) {
+            char* rc = &f.cells[2 * (static_cast<size_t>(e.r) * f.cols + e.c)];
+            rc[0] = alive ? e.weaponGlyph : 'X';
+            rc[1] = e.idGlyph;
+        }
+    }
+}
+
+template <class BoardT>
+bool ArenaT<BoardT>::occupiedAlive(int r,int c, int* idx_out) const {
+    int idx = -1;
+    if (!occupiedAny(r, c, &idx) || !m_robots[idx].alive) return false;
+    if (idx_out) *idx_out = idx;
+    return true;}
+template <class BoardT>
+bool ArenaT<BoardT>::occupiedAny(int r,int c,int* idx_out)const{
+    if (!m_board.inBounds(r, c)) return false;
+    int idx = m_occupancy[m_board.index(r, c)];
+    if (idx < 0) return false;
+    if (idx_out) *idx_out = idx;
+    return true;}
+
+// Robots on the ray come from the line indexes (living and corpses kept
+// apart, each already in ray order) and terrain from the jump table, so
+// the empty floor in between is never looked at.
+template <class BoardT>
+void ArenaT<BoardT>::scanDirection(const RobotEntry& re,int dir, std::vector<RadarObj>& out) const {
+    out.clear();
+    if (dir < 1 || dir > 8) return;
 
     int dr = directions[dir].first;
     int dc = directions[dir].second;
-    int r  = re.r + dr;
-    int c  = re.c + dc;
-
-    while (m_board.inBounds(r,c)) {
-        int idx = -1;
-        if (occupiedAny(r,c,&idx) && idx >= 0) {
-            const auto& e = m_robots[idx];
-
-            char type;
-            if (e.alive && e.bot->get_health() > 0) {
-                type = e.weaponGlyph;
-            } else {
-                type = 'X';
-            }
 
-            out.emplace_back(type, r, c);
-        }
-        Tile t = m_board.get(r,c);
-        if (t == Tile::Mound) {
-            out.emplace_back('M', r, c);
-        }
-        if (t == Tile::Pit) {
-            out.emplace_back('P', r, c);
-        }
-        if (t == Tile::Flame) {
-            out.emplace_back('F', r, c);
+    // (steps from re, robot index), nearest first; per deciding thread
+    thread_local std::vector<std::pair<int, int>> bodies;
+    bodies.clear();
+    auto gather = [&](const LineIndex::Occupant& o) {
+        bodies.emplace_back(std::max(std::abs(o.r - re.r), std::abs(o.c - re.c)), o.idx);
+    };
+    m_lines.forEachOnRay(re.r, re.c, dr, dc, gather);
+    size_t living = bodies.size();
+    m_corpses.forEachOnRay(re.r, re.c, dr, dc, gather);
+    std::inplace_merge(bodies.begin(), bodies.begin() + living, bodies.end());
+
+    auto body = bodies.begin();
+    auto emitBodiesUpTo = [&](int k) {
+        for (; body != bodies.end() && body->first <= k; ++body) {
+            const auto& e = m_robots[body->second];
+            char type = (e.alive && e.bot->get_health() > 0) ? e.weaponGlyph : 'X';
+            out.emplace_back(type, re.r + dr * body->first, re.c + dc * body->first);
         }
+    };
 
-        r += dr;
-        c += dc;
+    int k = 0;
+    for (;;) {
+        k += m_jumps.next(m_board.index(re.r + dr * k, re.c + dc * k), dir);
+        int r = re.r + dr * k, c = re.c + dc * k;
+        if (!m_board.inBounds(r, c)) break;
+        emitBodiesUpTo(k);
+        switch (m_board.get(r, c)) {
+            case Tile::Mound: out.emplace_back('M', r, c); break;
+            case Tile::Pit:   out.emplace_back('P', r, c); break;
+            case Tile::Flame: out.emplace_back('F', r, c); break;
+            default: break;     // floor past a saturated jump
+        }
     }
-    return out;
+    emitBodiesUpTo(std::numeric_limits<int>::max());
 }
 
 
@@ -160,7 +286,8 @@ std::vector<RadarObj> Arena::scanDirection(const RobotEntry& re,int dir) const {
 static constexpr bool SHOTS_BLOCKED_BY_BODIES=false;
 static constexpr bool SHOTS_BLOCKED_BY_MOUNDS=false;
 
-void Arena::resolveShot(const RobotEntry& shooterEntry, int shot_r, int shot_c) {
+template <class BoardT>
+void ArenaT<BoardT>::resolveShot(const RobotEntry& shooterEntry, int shot_r, int shot_c) {
     if (!m_board.inBounds(shooterEntry.r, shooterEntry.c)) return;
 
     auto weapon = shooterEntry.bot->get_weapon();
@@ -183,13 +310,15 @@ void Arena::resolveShot(const RobotEntry& shooterEntry, int shot_r, int shot_c)
     }
 }
 
-void Arena::resolveRailgunShot(const RobotEntry& shooterEntry, int shot_r, int shot_c){
+template <class BoardT>
+void ArenaT<BoardT>::resolveRailgunShot(const RobotEntry& shooterEntry, int shot_r, int shot_c){
     int sr = shooterEntry.r, sc = shooterEntry.c;
     int dr = (shot_r > sr) ? 1 : (shot_r < sr ? -1 : 0);
     int dc = (shot_c > sc) ? 1 : (shot_c < sc ? -1 : 0);
 
     if (!((sr == shot_r) || (sc == shot_c) ||
           (std::abs(shot_r - sr) == std::abs(shot_c - sc)))) return;
+    if (dr == 0 && dc == 0) return;     // no direction to fire along
 
     int shooterIdx = -1;
     for (int i = 0; i < (int)m_robots.size(); ++i) {
@@ -203,60 +332,65 @@ void Arena::resolveRailgunShot(const RobotEntry& shooterEntry, int shot_r, int s
     auto& shooter = m_robots[shooterIdx];
     shooter.shotsFired++;
 
-    int r = sr + dr, c = sc + dc;
-    while (m_board.inBounds(r,c)){
-        if (SHOTS_BLOCKED_BY_MOUNDS && m_board.get(r,c) == Tile::Mound) break;
-
-        int idx = -1;
-        if (occupiedAny(r,c,&idx) && idx >= 0) {
-            auto& tgt = m_robots[idx];
-
-            if (tgt.alive) {
-                int before = tgt.bot->get_health();
-                DM::applyArmorThenDegrade(*tgt.bot, DM::RailgunDamage);
-                int after = tgt.bot->get_health();
-                int dealt = before - after;
+    // The line index only holds living robots, so corpses (which never
+    // block) and empty cells are skipped. Targets are gathered first
+    // because a kill removes its robot from the line.
+    static_assert(!SHOTS_BLOCKED_BY_BODIES, "LineIndex does not hold corpses");
+    int reach = std::max(m_board.rows(), m_board.cols());
+    if constexpr (SHOTS_BLOCKED_BY_MOUNDS) {
+        int dir = RobotKit::dirOf(dr, dc);
+        for (int k = 0;;) {
+            k += m_jumps.next(m_board.index(sr + dr * k, sc + dc * k), dir);
+            if (!m_board.inBounds(sr + dr * k, sc + dc * k)) break;
+            if (m_board.get(sr + dr * k, sc + dc * k) == Tile::Mound) { reach = k - 1; break; }
+        }
+    }
 
-                shooter.shotsHit++;
-                shooter.damageDealt += dealt;
-                tgt.damageTaken += dealt;
+    m_rayHits.clear();
+    m_lines.forEachOnRay(sr, sc, dr, dc, [&](const LineIndex::Occupant& o) {
+        if (std::max(std::abs(o.r - sr), std::abs(o.c - sc)) <= reach)
+            m_rayHits.push_back(o.idx);
+    });
+    if (!m_rayHits.empty()) shooter.shotsLanded++;
 
-                if (dealt > 0) {
-                    m_damage_or_death_this_round = true;
-                }
+    for (int idx : m_rayHits) {
+        auto& tgt = m_robots[idx];
 
-                std::cout << "EVENT,SHOT,"
-                             << shooter.name << ","
-                             << tgt.name << ","
-                             << std::to_string(r) << ","
-                             << std::to_string(c) << ","
-                             << std::to_string(dealt);
-
-                if (after == 0) {
-                    tgt.alive = false;
-                    tgt.died = true;
-                    tgt.deathRow = tgt.r;
-                    tgt.deathCol = tgt.c;
-                    tgt.causeOfDeath =
-                        "railgun from " + shooter.name;
-                    shooter.kills++;
-                    m_damage_or_death_this_round = true;
+        int before = tgt.bot->get_health();
+        DM::applyArmorThenDegrade(*tgt.bot, DM::RailgunDamage);
+        int after = tgt.bot->get_health();
+        int dealt = before - after;
 
-                    std::cout << "EVENT,KILL,"
-                                 << shooter.name << ","
-                                 << tgt.name + ",railgun";
-                }
-            }
+        shooter.shotsHit++;
+        shooter.damageDealt += dealt;
+        tgt.damageTaken += dealt;
 
-            if (SHOTS_BLOCKED_BY_BODIES) break;
+        if (dealt > 0) {
+            m_damage_or_death_this_round = true;
         }
 
-        r += dr;
-        c += dc;
+        if (classicOutput())
+        std::cout << "EVENT,SHOT,"
+                     << shooter.name << ","
+                     << tgt.name << ","
+                     << std::to_string(tgt.r) << ","
+                     << std::to_string(tgt.c) << ","
+                     << std::to_string(dealt);
+
+        if (after == 0) {
+            markDead(tgt, {"railgun from ", shooter.name});
+            shooter.kills++;
+
+            if (classicOutput())
+            std::cout << "EVENT,KILL,"
+                         << shooter.name << ","
+                         << tgt.name << ",railgun";
+        }
     }
 }
 
-void Arena::resolveFlameShot(const RobotEntry& shooterEntry,
+template <class BoardT>
+void ArenaT<BoardT>::resolveFlameShot(const RobotEntry& shooterEntry,
                              int shot_r, int shot_c) {
     int sr = shooterEntry.r, sc = shooterEntry.c;
     int dr = (shot_r > sr) ? 1 : (shot_r < sr ? -1 : 0);
@@ -272,61 +406,12 @@ void Arena::resolveFlameShot(const RobotEntry& shooterEntry,
     auto& shooter = m_robots[shooterIdx];
     shooter.shotsFired++;
 
-    const int MAX_RANGE = 4;
-    const int HALF_WIDTH = 1;
-    for (int step = 1; step <= MAX_RANGE; ++step) {
-        int center_r = sr + dr * step;
-        int center_c = sc + dc * step;
-        if (!m_board.inBounds(center_r, center_c)) break;
-
-        for (int off = -HALF_WIDTH; off <= HALF_WIDTH; ++off) {
-            int r = center_r;
-            int c = center_c;
-
-            if (dr == 0 && dc != 0) {
-                r = center_r + off;
-            } else if (dc == 0 && dr != 0) {
-                c = center_c + off;
-            } else {
-                r = center_r + off;
-                c = center_c + off;
-            }
-
-            if (!m_board.inBounds(r,c)) continue;
-
-            int idx = -1;
-            if (occupiedAny(r,c,&idx) && idx >= 0) {
-                auto& tgt = m_robots[idx];
-                if (!tgt.alive) continue;
-
-                int before = tgt.bot->get_health();
-                DM::applyArmorThenDegrade(*tgt.bot, DM::FlamethrowerDamage); 
-                int after = tgt.bot->get_health();
-                int dealt = before - after;
-
-                if (dealt > 0) {
-                    shooter.shotsHit++;
-                    shooter.damageDealt += dealt;
-                    tgt.damageTaken     += dealt;
-                    m_damage_or_death_this_round = true;
-                }
-
-                if (after == 0) {
-                    tgt.alive = false;
-                    tgt.died  = true;    
-                    tgt.deathRow = tgt.r;
-                    tgt.deathCol = tgt.c;
-                    tgt.causeOfDeath = "flamethrower from " + shooter.name;
-                    shooter.kills++;
-                    m_damage_or_death_this_round = true;
-                }
-            }
-
-        }
-    }
+    applyAreaDamage(shooter, AoE::flameCone(dr, dc), sr, sc,
+                    DM::FlamethrowerDamage, "flamethrower");
 }
 
-void Arena::resolveHammerAttack(const RobotEntry& shooterEntry,
+template <class BoardT>
+void ArenaT<BoardT>::resolveHammerAttack(const RobotEntry& shooterEntry,
                                 int /*shot_r*/, int /*shot_c*/) {
     int sr = shooterEntry.r, sc = shooterEntry.c;
 
@@ -338,44 +423,11 @@ void Arena::resolveHammerAttack(const RobotEntry& shooterEntry,
     auto& shooter = m_robots[shooterIdx];
     shooter.shotsFired++;
 
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int dc = -1; dc <= 1; ++dc) {
-            if (dr == 0 && dc == 0) continue;
-            int r = sr + dr;
-            int c = sc + dc;
-            if (!m_board.inBounds(r,c)) continue;
-
-            int idx = -1;
-            if (!occupiedAny(r,c,&idx) || idx < 0) continue;
-            auto& tgt = m_robots[idx];
-            if (!tgt.alive) continue;
-
-            int before = tgt.bot->get_health();
-            DM::applyArmorThenDegrade(*tgt.bot, DM::HammerDamage); 
-            int after = tgt.bot->get_health();
-            int dealt = before - after;
-
-            if (dealt > 0) {
-                shooter.shotsHit++;
-                shooter.damageDealt += dealt;
-                tgt.damageTaken     += dealt;
-                m_damage_or_death_this_round = true;
-            }
-
-            if (after == 0) {
-                tgt.alive = false;
-                tgt.died  = true;
-                tgt.deathRow = tgt.r;
-                tgt.deathCol = tgt.c;
-                tgt.causeOfDeath = "hammer from " + shooter.name;
-                shooter.kills++;
-                m_damage_or_death_this_round = true;
-            }
-        }
-    }
+    applyAreaDamage(shooter, AoE::hammer(), sr, sc, DM::HammerDamage, "hammer");
 }
 
-void Arena::resolveGrenade(const RobotEntry& shooterEntry,
+template <class BoardT>
+void ArenaT<BoardT>::resolveGrenade(const RobotEntry& shooterEntry,
                            int shot_r, int shot_c) {
     int sr = shooterEntry.r, sc = shooterEntry.c;
 
@@ -387,64 +439,66 @@ void Arena::resolveGrenade(const RobotEntry& shooterEntry,
     auto& shooter = m_robots[shooterIdx];
 
     // limit range
-    const int MAX_RANGE = 6;
     int manhattan = std::abs(shot_r - sr) + std::abs(shot_c - sc);
-    if (manhattan > MAX_RANGE) return;
+    if (manhattan > DM::GrenadeRange) return;
 
     shooter.shotsFired++;
 
-    const int BLAST_RADIUS = 1; 
-    for (int dr = -BLAST_RADIUS; dr <= BLAST_RADIUS; ++dr) {
-        for (int dc = -BLAST_RADIUS; dc <= BLAST_RADIUS; ++dc) {
-            int r = shot_r + dr;
-            int c = shot_c + dc;
-            if (!m_board.inBounds(r,c)) continue;
-
-            int idx = -1;
-            if (!occupiedAny(r,c,&idx) || idx < 0) continue;
-            auto& tgt = m_robots[idx];
-            if (!tgt.alive) continue;
-
-            int before = tgt.bot->get_health();
-            DM::applyArmorThenDegrade(*tgt.bot, DM::GrenadeDamage);
-            int after = tgt.bot->get_health();
-            int dealt = before - after;
+    applyAreaDamage(shooter, AoE::grenadeBlast(), shot_r, shot_c, DM::GrenadeDamage, "grenade");
+}
 
-            if (dealt > 0) {
-                shooter.shotsHit++;
-                shooter.damageDealt += dealt;
-                tgt.damageTaken     += dealt;
-                m_damage_or_death_this_round = true;
-            }
+template <class BoardT>
+void ArenaT<BoardT>::applyAreaDamage(RobotEntry& shooter, const AoeShape& shape, int r0, int c0,
+                            int damage, const char* weapon) {
+    m_rayHits.clear();
+    AoE::gather(m_occupancy, m_board.rows(), m_board.cols(), shape, r0, c0, m_rayHits);
+
+    bool landed = false;
+    for (int idx : m_rayHits) {
+        auto& tgt = m_robots[idx];
+        if (!tgt.alive) continue;
+
+        int before = tgt.bot->get_health();
+        DM::applyArmorThenDegrade(*tgt.bot, damage);
+        int after = tgt.bot->get_health();
+        int dealt = before - after;
+
+        if (dealt > 0) {
+            shooter.shotsHit++;
+            landed = true;
+            shooter.damageDealt += dealt;
+            tgt.damageTaken     += dealt;
+            m_damage_or_death_this_round = true;
+        }
 
-            if (after == 0) {
-                tgt.alive = false;
-                tgt.died  = true;
-                tgt.deathRow = tgt.r;
-                tgt.deathCol = tgt.c;
-                tgt.causeOfDeath = "grenade from " + shooter.name;
-                shooter.kills++;
-                m_damage_or_death_this_round = true;
-            }
+        if (after == 0) {
+            markDead(tgt, {weapon, " from ", shooter.name});
+            shooter.kills++;
         }
     }
+    if (landed) shooter.shotsLanded++;
 }
 
-
-void Arena::applyMovement(RobotEntry& re, int dir, int dist) {
+template <class BoardT>
+void ArenaT<BoardT>::applyMovement(RobotEntry& re, int dir, int dist) {
     if (!re.alive || re.trappedInPit) return;
     if (dir < 1 || dir > 8 || dist <= 0) return;
 
     dist = std::min(dist, re.bot->get_move_speed());
     int dr = directions[dir].first;
     int dc = directions[dir].second;
+    // steps ahead known to be in-bounds floor; only occupancy can stop those
+    int floor = m_jumps.next(m_board.index(re.r, re.c), dir) - 1;
 
     for (int step = 0; step < dist; ++step) {
         int nr = re.r + dr;
         int nc = re.c + dc;
 
-        if (!m_board.inBounds(nr, nc)) break;
-        if (m_board.get(nr, nc) == Tile::Mound) break;
+        bool plain = floor-- > 0;
+        if (!plain) {
+            if (!m_board.inBounds(nr, nc)) break;
+            if (m_board.get(nr, nc) == Tile::Mound) break;
+        }
 
         int idx = -1;
         if (occupiedAny(nr, nc, &idx)) {
@@ -469,28 +523,18 @@ void Arena::applyMovement(RobotEntry& re, int dir, int dist) {
                     m_damage_or_death_this_round = true;
                 }
                 if (afterA == 0 && !re.died) {
-                    re.alive = false;
-                    re.died  = true;
-                    re.causeOfDeath = "collision with " + other.name;
-                    m_damage_or_death_this_round = true;
-                    re.deathRow = re.r;
-                    re.deathCol = re.c;
+                    markDead(re, {"collision with ", other.name});
                 }
                 if (afterB == 0 && !other.died) {
-                    other.alive = false;
-                    other.died  = true;
-                    other.causeOfDeath = "collision with " + re.name;
-                    m_damage_or_death_this_round = true;
-                    other.deathRow = other.r;
-                    other.deathCol = other.c;
+                    markDead(other, {"collision with ", re.name});
                 }
             }
             break;
         }
 
-        re.r = nr;
-        re.c = nc;
-        re.bot->move_to(nr, nc);
+        moveEntry(re, nr, nc);
+        if (plain) continue;
+        floor = m_jumps.next(m_board.index(nr, nc), dir) - 1;
 
         Tile t = m_board.get(nr, nc);
         if (t == Tile::Pit) {
@@ -500,9 +544,8 @@ void Arena::applyMovement(RobotEntry& re, int dir, int dist) {
         }
 
         if (m_board.get(nr, nc) == Tile::Flame) {
-            static std::mt19937 rng(std::random_device{}());
-            std::uniform_int_distribution<int> flameDmgDist(30, 50); //30 to 50 damage per spec
-            int dmg = flameDmgDist(rng);
+            std::uniform_int_distribution<int> flameDmgDist(DM::FlameTileMin, DM::FlameTileMax); //30 to 50 damage per spec
+            int dmg = flameDmgDist(m_rng);
 
             int before = re.bot->get_health();
             DM::applyArmorThenDegrade(*re.bot, dmg);  //now uses armor ANDdegrades it
@@ -515,12 +558,7 @@ void Arena::applyMovement(RobotEntry& re, int dir, int dist) {
             }
 
             if (after == 0 && !re.died) {
-                re.alive = false;
-                re.died  = true;
-                re.causeOfDeath = "flame";
-                re.deathRow = nr;
-                re.deathCol = nc;
-                m_damage_or_death_this_round = true;
+                markDead(re, {"flame"});
             }
 
             if (!re.alive) break;
@@ -529,68 +567,314 @@ void Arena::applyMovement(RobotEntry& re, int dir, int dist) {
 }
 
 
-bool Arena::doTurnAndReportAction(RobotEntry& re){
-    if (!re.alive || re.bot->get_health() <= 0) {
-        re.alive = false;
-        return false;
+template <class BoardT>
+void ArenaT<BoardT>::moveEntry(RobotEntry& re, int r, int c) {
+    int idx = static_cast<int>(&re - m_robots.data());
+    if (re.alive) {
+        m_lines.remove(idx, re.r, re.c);
+        m_lines.insert(idx, r, c);
     }
+    m_occupancy[m_board.index(re.r, re.c)] = -1;
+    m_occupancy[m_board.index(r, c)] = idx;
+    re.r = r;
+    re.c = c;
+    re.bot->move_to(r, c);
+}
 
-    bool acted = false;
+template <class BoardT>
+void ArenaT<BoardT>::retireEntry(RobotEntry& re) {
+    if (!re.alive) return;
+    int idx = static_cast<int>(&re - m_robots.data());
+    m_lines.remove(idx, re.r, re.c);
+    m_corpses.insert(idx, re.r, re.c);
+    re.alive = false;
+}
 
-    int radar_dir = 0;
-    re.bot->get_radar_direction(radar_dir);
-    auto hits = scanDirection(re, radar_dir);
+template <class BoardT>
+void ArenaT<BoardT>::markDead(RobotEntry& re, std::initializer_list<std::string_view> cause) {
+    retireEntry(re);
+    re.died  = true;
+    re.deathRow = re.r;
+    re.deathCol = re.c;
+    re.causeOfDeath.clear();
+    for (std::string_view part : cause) re.causeOfDeath.append(part);
+    m_damage_or_death_this_round = true;
+}
 
-    re.bot->process_radar_results(hits);
+template <class BoardT>
+bool ArenaT<BoardT>::decideTurn(RobotEntry& re, TurnDecision& d){
+    d = TurnDecision{};
+    const int self = static_cast<int>(&re - m_robots.data());
+    // nothing may call the robot while it thinks in the background
+    if (re.anytime) m_anytime.pause(self);
+    if (!re.alive || re.bot->get_health() <= 0) {
+        retireEntry(re);
+        return false;
+    }
 
-    int sr = 0, sc = 0;
-    bool shot = re.bot->get_shot_location(sr, sc);
+    re.bot->get_radar_direction(d.radarDir);
+    // one scan buffer per deciding thread, reused every turn; span radar
+    // robots read it in place, others get it as process_radar_results' vector
+    thread_local std::vector<RadarObj> hits;
+    scanDirection(re, d.radarDir, hits);
+
+    if (re.spanRadar)
+        re.spanRadar->process_radar_span(hits, summarizeRadar(hits, re.r, re.c));
+    else
+        re.bot->process_radar_results(hits);
+
+    if (re.anytime) {
+        AnytimeAction a = m_anytime.turn(self, *re.anytime,
+                                         std::chrono::microseconds(m_options.thinkBudgetUs));
+        if (a.kind == AnytimeAction::Shot || (a.kind == AnytimeAction::Move && a.a != 0 && a.b > 0)) {
+            d.action = static_cast<TurnAction>(a.kind);
+            d.a = a.a;
+            d.b = a.b;
+        }
+        return true;
+    }
 
-    if (shot) {
-        std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph
-                  << " shoots at (" << sr << "," << sc << ")\n";
-        resolveShot(re, sr, sc);
-        acted = true;
+    if (re.bot->get_shot_location(d.a, d.b)) {
+        d.action = TurnAction::Shot;
     } else {
         int md = 0, dist = 0;
         re.bot->get_move_direction(md, dist);
         if (md != 0 && dist > 0) {
-            std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph
-                      << " moves: dir=" << md
-                      << " dist=" << dist << "\n";
-            applyMovement(re, md, dist);
-            acted = true;
-        } else {
-            std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph << " does nothing.\n";
+            d.action = TurnAction::Move;
+            d.a = md;
+            d.b = dist;
         }
     }
-    return acted;
+    return true;
+}
+
+template <class BoardT>
+bool ArenaT<BoardT>::applyTurn(RobotEntry& re, const TurnDecision& d){
+    int self = static_cast<int>(&re - m_robots.data());
+    if (m_replay) m_replay->action(self, d.radarDir, static_cast<ReplayActionKind>(d.action), d.a, d.b);
+
+    // A robot that gave up while deciding (a SandboxedRobot whose worker
+    // crashed or hung) only raised its flag; the forfeit lands here, in
+    // turn order, so robots deciding alongside it never saw it change.
+    if (re.alive && re.forfeit && re.forfeit->forfeited()) {
+        if (classicOutput())
+            std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph << " forfeits.\n";
+        re.bot->take_damage(re.bot->get_health());
+        markDead(re, {"forfeit"});
+        return false;
+    }
+
+    switch (d.action) {
+        case TurnAction::Shot:
+            if (classicOutput())
+                std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph
+                          << " shoots at (" << d.a << "," << d.b << ")\n";
+            resolveShot(re, d.a, d.b);
+            return true;
+        case TurnAction::Move:
+            if (classicOutput())
+                std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph
+                          << " moves: dir=" << d.a
+                          << " dist=" << d.b << "\n";
+            applyMovement(re, d.a, d.b);
+            return true;
+        default:
+            if (classicOutput())
+                std::cout << "Robot " << re.name << re.weaponGlyph << re.idGlyph << " does nothing.\n";
+            return false;
+    }
+}
+
+template <class BoardT>
+bool ArenaT<BoardT>::doTurnAndReportAction(RobotEntry& re){
+    TurnDecision d;
+    if (!decideTurn(re, d)) return false;
+    return applyTurn(re, d);
+}
+
+// Runs every robot's decision against the current world, which nothing
+// modifies until all of them are in. With a pool the calls run in
+// parallel: each robot only touches its own RobotEntry and decision slot
+// and reads the board and occupancy, so the one write decideTurn can make
+// to shared state (retiring a robot found dead) is done up front.
+template <class BoardT>
+void ArenaT<BoardT>::decideAll(){
+    const size_t n = m_robots.size();
+    m_decisions.resize(n);
+    m_decided.resize(n);
+    if (!m_pool) {
+        for (size_t i = 0; i < n; ++i)
+            m_decided[i] = decideTurn(m_robots[i], m_decisions[i]);
+        return;
+    }
+
+    for (auto& re : m_robots) {
+        if (re.alive && re.bot->get_health() <= 0) retireEntry(re);
+    }
+    if (m_regions.active()) {
+        // one task per region; robots not listed anywhere died before this round
+        std::fill(m_decided.begin(), m_decided.end(), 0);
+        m_pool->parallelFor(m_regions.count(), [this](size_t g) {
+            for (int i : m_regions.robots(static_cast<int>(g)))
+                m_decided[i] = decideTurn(m_robots[i], m_decisions[i]);
+        });
+        return;
+    }
+    m_pool->parallelFor(n, [this](size_t i) {
+        m_decided[i] = decideTurn(m_robots[i], m_decisions[i]);
+    }, 4);
+}
+
+// Decisions are all made up front, then applied one robot at a time in
+// roster order exactly as the sequential loop would.
+template <class BoardT>
+bool ArenaT<BoardT>::playSnapshotTurns(){
+    decideAll();
+
+    bool any_action = false;
+    for (size_t i = 0; i < m_robots.size(); ++i) {
+        if (aliveCount() <= 1) break;
+        if (!m_decided[i] || !m_robots[i].alive) continue;
+        any_action = applyTurn(m_robots[i], m_decisions[i]) || any_action;
+    }
+    return any_action;
+}
+
+// Every living robot decides against the world as the last round left it;
+// nothing moves or takes damage until all decisions are in. Then all shots
+// resolve in roster order, fired from round-start positions (a robot killed
+// by an earlier shot this round still gets its shot off), and after that
+// the survivors move in roster order, colliding with whatever is there by then.
+template <class BoardT>
+bool ArenaT<BoardT>::playSimultaneousTurns(){
+    decideAll();
+
+    bool any_action = false;
+    for (size_t i = 0; i < m_robots.size(); ++i) {
+        if (m_decided[i] && m_decisions[i].action != TurnAction::Move)
+            any_action = applyTurn(m_robots[i], m_decisions[i]) || any_action;
+    }
+    for (size_t i = 0; i < m_robots.size(); ++i) {
+        if (!m_decided[i] || m_decisions[i].action != TurnAction::Move) continue;
+        if (!m_robots[i].alive) {
+            // killed during the shot phase: the move never happens
+            TurnDecision none;
+            none.radarDir = m_decisions[i].radarDir;
+            applyTurn(m_robots[i], none);
+            continue;
+        }
+        any_action = applyTurn(m_robots[i], m_decisions[i]) || any_action;
+    }
+    return any_action;
 }
 
 //RUN: GAME LOOP
-void Arena::run(int ms_delay_between_rounds){
-    std::cout << "Starting Robot Warz on "
-              << m_board.rows() << "x" << m_board.cols() << " board.\n";
+template <class BoardT>
+void ArenaT<BoardT>::run(){
+    startGame();
+    while (playRound()) {}
+    finishGame();
+}
 
-    int round = 0;
+template <class BoardT>
+void ArenaT<BoardT>::startGame(){
+    if (m_output != OutputMode::Silent)
+        std::cout << "Starting Robot Warz on "
+                  << m_board.rows() << "x" << m_board.cols() << " board.\n";
+
+    m_spawnsValid = false;   // robots move from here on
+    m_regions.reset(m_board.rows(), m_board.cols(), m_options.regionSize);
+    if (m_regions.active()) {
+        for (size_t i = 0; i < m_robots.size(); ++i)
+            if (m_robots[i].alive) m_regions.insert(static_cast<int>(i), m_robots[i].r, m_robots[i].c);
+    }
+    m_round = 0;
+    m_stalemate = false;
+    m_stalemateKind = StalemateKind::NoDamage;
     rounds_since_action = 0;
+    m_robotKeys.assign(m_robots.size(), 0);
+    m_stateHash = 0;
+    m_history.clear();
+    m_lastSeen.clear();
+    m_cyclePeriod = 0;
+    m_repeats = 0;
+    updateStateHash();
 
     auto now = std::time(nullptr);
-    long gameId = static_cast<long>(now);
+    m_gameId = static_cast<long>(now);
+    if (m_replay) m_replay->begin(m_board, m_robots);
+    if (m_viewer && !classicOutput()) {
+        std::cout.flush();
+        m_viewer->invalidate();
+    }
+}
+
+template <class BoardT>
+void ArenaT<BoardT>::updateStateHash() {
+    for (size_t i = 0; i < m_robots.size(); ++i) {
+        const auto& re = m_robots[i];
+        uint64_t key = Stalemate::robotKey(static_cast<int>(i), re.r, re.c,
+                                           re.bot->get_health(), re.bot->get_armor(),
+                                           re.bot->get_grenades(), re.alive, re.trappedInPit);
+        m_stateHash ^= m_robotKeys[i] ^ key;
+        m_robotKeys[i] = key;
+    }
+}
 
-    while (aliveCount() > 1) {     
-        ++round;
+template <class BoardT>
+void ArenaT<BoardT>::trackCycle() {
+    if (m_damage_or_death_this_round) {
+        m_history.clear();
+        m_lastSeen.clear();
+        m_cyclePeriod = 0;
+        m_repeats = 0;
+        return;
+    }
+    const int t = static_cast<int>(m_history.size());
+    m_history.push_back(m_stateHash);
+    if (m_cyclePeriod > 0 && m_history[t - m_cyclePeriod] == m_stateHash) {
+        ++m_repeats;
+    } else {
+        // start counting again from the last time this state was seen, if ever
+        auto it = m_lastSeen.find(m_stateHash);
+        m_cyclePeriod = it == m_lastSeen.end() ? 0 : t - it->second;
+        m_repeats = m_cyclePeriod > 0 ? 1 : 0;
+    }
+    m_lastSeen[m_stateHash] = t;
+}
+
+template <class BoardT>
+void ArenaT<BoardT>::publishFrame(bool force){
+    if (!m_viewer || classicOutput()) return;
+    if (!force && !m_viewer->wantsFrame()) return;
+    captureFrame(m_viewer->back(), m_round);
+    m_viewer->publish();
+}
+
+template <class BoardT>
+bool ArenaT<BoardT>::playRound(){
+    if (aliveCount() <= 1) return false;
+
+    ++m_round;
+    if (classicOutput()) {
         std::cout << "\n\n";
-        std::cout << "\n=== Round " << round << " ===\n";
+        std::cout << "\n=== Round " << m_round << " ===\n";
+    }
 
-        m_damage_or_death_this_round = false;
+    m_damage_or_death_this_round = false;
 
-        bool any_action = false;
+    if (m_options.turns == TurnMode::Simultaneous) {
+        playSimultaneousTurns();
+    } else if (m_options.turns == TurnMode::Snapshot) {
+        playSnapshotTurns();
+    } else {
         for (auto& re : m_robots) {
             if (aliveCount() <= 1) break;
-            any_action = doTurnAndReportAction(re) || any_action;
+            doTurnAndReportAction(re);
         }
+    }
 
+    if (classicOutput()) {
         printBoard(std::cout);
 
         for (auto& re : m_robots) {
@@ -598,50 +882,124 @@ void Arena::run(int ms_delay_between_rounds){
                       << re.bot->print_stats()
                       << (re.alive ? "" : "  [DEAD]") << "\n";
         }
+    } else {
+        publishFrame(false);
+    }
 
-        if (m_damage_or_death_this_round) {
-            rounds_since_action = 0;
-        } else {
-            ++rounds_since_action;
-        }
+    if (m_damage_or_death_this_round) {
+        rounds_since_action = 0;
+    } else {
+        ++rounds_since_action;
+    }
 
-        for (auto& re : m_robots) {
-            if (re.alive && re.bot->get_health() > 0) {
-                re.roundsAlive++;
-            }
+    for (auto& re : m_robots) {
+        if (re.alive && re.bot->get_health() > 0) {
+            re.roundsAlive++;
         }
+    }
+    if (m_replay) m_replay->endRound(m_round, m_robots);
+    if (m_regions.active()) {
+        m_regions.migrate([this](int i) { return m_robots[i].alive; },
+                          [this](int i, int& r, int& c) { r = m_robots[i].r; c = m_robots[i].c; });
+    }
 
-        // stalemate check
-        if (rounds_since_action >= STALEMATE_ROUNDS && aliveCount() > 1) {
-            std::cout << "\n=== Stalemate Reached ("
-                      << STALEMATE_ROUNDS
-                      << " rounds without damage or kills). Co-winners: ===\n";
-            for (auto& re : m_robots) {
-                if (re.alive && re.bot->get_health() > 0) {
-                    std::cout << re.name << "\n";
-                }
-            }
-            writeReaperStats(gameId);
-            return;
+    updateStateHash();
+    if (m_options.repeatLimit > 0) trackCycle();
+
+    // stalemate check
+    if (aliveCount() > 1) {
+        if (rounds_since_action >= STALEMATE_ROUNDS) {
+            m_stalemate = true;
+            m_stalemateKind = StalemateKind::NoDamage;
+            return false;
+        }
+        if (m_options.repeatLimit > 0 && m_repeats >= m_options.repeatLimit) {
+            m_stalemate = true;
+            m_stalemateKind = StalemateKind::Repeated;
+            return false;
+        }
+        if (m_options.proofInterval > 0 && rounds_since_action > 0 &&
+            rounds_since_action % m_options.proofInterval == 0 &&
+            Stalemate::harmless(m_board, m_robots, m_occupancy)) {
+            m_stalemate = true;
+            m_stalemateKind = StalemateKind::Proven;
+            return false;
         }
+    }
+    // round cap from the config: survivors share the win like a stalemate
+    if (m_options.maxRounds > 0 && m_round >= m_options.maxRounds && aliveCount() > 1) {
+        m_stalemate = true;
+        m_stalemateKind = StalemateKind::RoundCap;
+        return false;
+    }
+    return aliveCount() > 1;
+}
+
+template <class BoardT>
+void ArenaT<BoardT>::finishGame(){
+    m_anytime.clear();
+    if (m_viewer && !classicOutput()) {
+        publishFrame(true);
+        m_viewer->drain();
+    }
 
-        if (ms_delay_between_rounds > 0) {
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(ms_delay_between_rounds)
-            );
+    writeReaperStats(m_gameId);
+    if (m_stats) m_stats->recordGame(m_robots, m_round, m_stalemate);
+    if (m_replay) m_replay->finish(m_round, m_stalemate);
+    if (m_output != OutputMode::Silent) printResult(std::cout);
+}
+
+template <class BoardT>
+void ArenaT<BoardT>::printResult(std::ostream& os) const {
+    if (m_stalemate) {
+        switch (m_stalemateKind) {
+            case StalemateKind::RoundCap:
+                os << "\n=== Round Limit Reached ("
+                   << m_options.maxRounds << " rounds). Co-winners: ===\n";
+                break;
+            case StalemateKind::Repeated:
+                os << "\n=== Stalemate Reached (positions cycling every "
+                   << m_cyclePeriod << " rounds for " << m_repeats
+                   << " rounds without damage). Co-winners: ===\n";
+                break;
+            case StalemateKind::Proven:
+                os << "\n=== Stalemate Reached (no robot can reach another, "
+                   << rounds_since_action << " rounds without damage). Co-winners: ===\n";
+                break;
+            default:
+                os << "\n=== Stalemate Reached ("
+                   << STALEMATE_ROUNDS
+                   << " rounds without damage or kills). Co-winners: ===\n";
+        }
+        for (auto& re : m_robots) {
+            if (re.alive && re.bot->get_health() > 0) {
+                os << re.name << "\n";
+            }
         }
+        return;
     }
-    writeReaperStats(gameId);
 
-    std::cout << "\n=== Game Over ===\n";
+    os << "\n=== Game Over ===\n";
     for (auto& re : m_robots) {
         if (re.alive && re.bot->get_health() > 0) {
-            std::cout << "Winner: " << re.name << "\n";
+            os << "Winner: " << re.name << "\n";
         }
     }
 }
 
-void Arena::writeReaperStats(long gameId) {
+template <class BoardT>
+GameMemory ArenaT<BoardT>::gameMemory() const {
+    return { m_gameMemory.allocations(), m_gameMemory.bytes(),
+             m_heapSide.allocations(), m_heapSide.bytes() };
+}
+
+template <class BoardT>
+void ArenaT<BoardT>::writeReaperStats(long gameId) {
+    auto isMyReaper = [](const RobotEntry& re) {
+        return re.bot->get_weapon() == railgun && re.name.rfind("Reaper_", 0) == 0;
+    };
+    // no file at all for games without a Reaper (BatchEnv's, for one)
+    if (std::none_of(m_robots.begin(), m_robots.end(), isMyReaper)) return;
     std::ofstream reaperFile("reaper_only_stats.csv", std::ios::app);
     if (!reaperFile) return;
 
@@ -654,11 +1012,7 @@ void Arena::writeReaperStats(long gameId) {
     }
 
     for (auto& re : m_robots) {
-        bool isMyReaper =
-            (re.bot->get_weapon() == railgun) &&
-            (re.name.rfind("Reaper_", 0) == 0); 
-
-        if (!isMyReaper) continue;
+        if (!isMyReaper(re)) continue;
 
         bool survived = (re.alive && re.bot->get_health() > 0);
         std::string weapon(1, re.weaponGlyph);
@@ -683,18 +1037,21 @@ void Arena::writeReaperStats(long gameId) {
 }
 
 
-bool Arena::isObstacle(int row, int col) const {
+template <class BoardT>
+bool ArenaT<BoardT>::isObstacle(int row, int col) const {
     Tile t = m_board.get(row, col);
     return (t == Tile::Mound ||
             t == Tile::Pit   ||
             t == Tile::Flame);
 }
 
-bool Arena::hasRobot(int row, int col) const {
+template <class BoardT>
+bool ArenaT<BoardT>::hasRobot(int row, int col) const {
     return occupiedAny(row, col, nullptr);
 }
 
-bool Arena::hasAdjacentRobot(int row, int col) const {
+template <class BoardT>
+bool ArenaT<BoardT>::hasAdjacentRobot(int row, int col) const {
     for (int dr = -1; dr <= 1; ++dr) {
         for (int dc = -1; dc <= 1; ++dc) {
             if (dr == 0 && dc == 0) continue;
@@ -706,7 +1063,8 @@ bool Arena::hasAdjacentRobot(int row, int col) const {
     }
     return false;
 }
-bool Arena::isValidSpawn(int r, int c) const {
+template <class BoardT>
+bool ArenaT<BoardT>::isValidSpawn(int r, int c) const {
     if (r < 0 || r >= m_board.rows() || c < 0 || c >= m_board.cols()) return false;
     if (isObstacle(r, c)) return false;
     if (hasRobot(r, c))   return false;
@@ -722,97 +1080,108 @@ bool Arena::isValidSpawn(int r, int c) const {
     }
     return true;
 }
-#include <random>
+template <class BoardT>
+SpawnIndex& ArenaT<BoardT>::spawnIndex() {
+    if (!m_spawnsValid) {
+        m_spawns.build(m_board);
+        for (const auto& re : m_robots) m_spawns.claim(re.r, re.c);
+        m_spawnsValid = true;
+    }
+    return m_spawns;
+}
 
-void Arena::addRobotRandom(RobotBase* robot,
+template <class BoardT>
+bool ArenaT<BoardT>::addRobotRandom(RobotBase* robot,
                            const std::string& name,
                            char symbol) {
-    static std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<int> rowDist(0, m_board.rows() - 1);
-    std::uniform_int_distribution<int> colDist(0, m_board.cols() - 1);
-
-    int attempts = 0;
-    const int maxAttempts = 1000; // safety
+    SpawnIndex& spawns = spawnIndex();
+    if (spawns.empty()) {
+        std::cerr << "Warning: could not place robot " << name
+                  << ": no free cell left.\n";
+        return false;
+    }
+    int r = 0, c = 0;
+    spawns.pick(m_rng, r, c);
+    addRobot(robot, name, symbol, r, c);    // claims the cell
+    return true;
+}
 
-    while (attempts < maxAttempts) {
-        ++attempts;
-        int r = rowDist(rng);
-        int c = colDist(rng);
-        if (isValidSpawn(r, c)) {
-            addRobot(robot, name, symbol, r, c);
-            return;
+template <class BoardT>
+size_t ArenaT<BoardT>::addRobotsRandom(const std::vector<RobotSpawn>& robots) {
+    m_robots.reserve(m_robots.size() + robots.size());
+    SpawnIndex& spawns = spawnIndex();
+
+    // Random cells first, drawn on a copy of the index: random picks can
+    // box themselves in (on a 3x3 board only the four corners seat four
+    // robots), and then a complete search over the free cells takes over.
+    SpawnIndex trial = spawns;
+    std::vector<int> cells;
+    while (cells.size() < robots.size() && !trial.empty()) {
+        int r = 0, c = 0;
+        trial.pick(m_rng, r, c);
+        trial.claim(r, c);
+        cells.push_back(r * m_board.cols() + c);
+    }
+    if (cells.size() < robots.size()) {
+        std::vector<int> packed;
+        if (spawns.pack(robots.size(), packed)) {
+            std::shuffle(packed.begin(), packed.end(), m_rng);
+            cells.swap(packed);
         }
     }
 
-    std::cerr << "Warning: could not place robot " << name
-              << " after " << maxAttempts << " attempts.\n";
+    size_t placed = 0;
+    for (const auto& spawn : robots) {
+        if (placed < cells.size()) {
+            addRobot(spawn.bot, spawn.name, spawn.weaponGlyph,
+                     cells[placed] / m_board.cols(), cells[placed] % m_board.cols());
+            ++placed;
+        } else {
+            std::cerr << "Warning: could not place robot " << spawn.name
+                      << ": no free cell left.\n";
+            if (m_robotPool) m_robotPool->release(spawn.bot);
+            else delete spawn.bot;
+        }
+    }
+    return placed;
 }
 
-std::string Arena::boardCellString(int r, int c) const {
+template <class BoardT>
+void ArenaT<BoardT>::boardCellChars(int r, int c, char out[2]) const {
     int idx = -1;
     if (occupiedAny(r, c, &idx) && idx >= 0) {
         const auto& e = m_robots[idx];
 
-        char base = (e.alive && e.bot->get_health() > 0)
-                    ? e.weaponGlyph    
-                    : 'X';             // dead
-
-        std::string s;
-        s += base;
-        s += e.idGlyph;                
-        return s;
+        out[0] = (e.alive && e.bot->get_health() > 0)
+                 ? e.weaponGlyph    
+                 : 'X';             // dead
+        out[1] = e.idGlyph;
+        return;
     }
 
-    Tile t = m_board.get(r, c);
-    switch (t) {
-        case Tile::Mound: return " M";
-        case Tile::Pit:   return " P";
-        case Tile::Flame: return " F";
-        default:          return " .";
-    }
+    out[0] = ' ';
+    out[1] = tileGlyph(m_board.get(r, c));
 }
 
-void Arena::seedRandomTerrain()
+// Draws a count from a per-400-cell range and scales it to this board.
+template <class BoardT>
+int ArenaT<BoardT>::scaledCount(const TerrainRange& range)
 {
-    static std::mt19937 rng(std::random_device{}());
-
-    std::uniform_int_distribution<int> rowDist(0, m_board.rows() - 1);
-    std::uniform_int_distribution<int> colDist(0, m_board.cols() - 1);
-
-    auto isEmpty = [&](int r, int c) {
-        // Replace Tile::Empty with whatever your “open” tile is
-        Tile t = m_board.get(r, c);
-        return (t != Tile::Mound &&
-                t != Tile::Pit   &&
-                t != Tile::Flame);
-    };
-
-    auto placeMany = [&](Tile tileType, int count) {
-        int placed   = 0;
-        int attempts = 0;
-        const int MAX_ATTEMPTS = 10'000;
-
-        while (placed < count && attempts < MAX_ATTEMPTS) {
-            ++attempts;
-            int r = rowDist(rng);
-            int c = colDist(rng);
-
-            if (!isEmpty(r, c)) continue;
-
-            m_board.set(r, c, tileType);
-            ++placed;
-        }
-    };
-
-    std::uniform_int_distribution<int> pitCountDist(1, 3);
-    std::uniform_int_distribution<int> flameCountDist(2, 5);
-    std::uniform_int_distribution<int> moundCountDist(3, 5);
-
-    int numPits   = pitCountDist(rng);
-    int numFlames = flameCountDist(rng);
-    int numMounds = moundCountDist(rng);
+    std::uniform_int_distribution<int> dist(range.min, range.max);
+    double area = static_cast<double>(m_board.rows()) * m_board.cols();
+    return static_cast<int>(std::lround(dist(m_rng) * area / 400.0));
+}
 
-    placeMany(Tile::Pit,   numPits);
-    placeMany(Tile::Flame, numFlames);
-    placeMany(Tile::Mound, numMounds);
+template <class BoardT>
+void ArenaT<BoardT>::seedRandomTerrain()
+{
+    TerrainCounts counts;
+    counts.pits   = scaledCount(m_options.pits);
+    counts.flames = scaledCount(m_options.flames);
+    counts.mounds = scaledCount(m_options.mounds);
+    TerrainGen::generate(m_board, m_options.terrain, counts, m_rng);
+    m_jumps.build(m_board);
 }
+
+template class ArenaT<Board>;
+template class ArenaT<StandardBoard>;
@@ -2,21 +2,65 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
+#include <span>
+#include <initializer_list>
 #include <utility>
+#include <random>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
 #include "Board.h"
 #include "RobotBase.h"
 #include "RadarObj.h"
+#include "ArenaFrame.h"
+#include "SpawnIndex.h"
+#include "TerrainGen.h"
+#include "LineIndex.h"
+#include "JumpTable.h"
+#include "AoE.h"
+#include "RegionGrid.h"
+#include "CountingResource.h"
+#include "WorldState.h"
+#include "SpanRadarRobot.h"
+#include "ForfeitingRobot.h"
+#include "AnytimeScheduler.h"
 
+class TournamentStats;
+class ReplayWriter;
+class LiveViewer;
+class ThreadPool;
+class RobotPool;
+
+// Strings live in the owning arena's per-game memory; the allocator-extended
+// constructors let std::pmr::vector place entries and their strings there.
 struct RobotEntry {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    RobotEntry() = default;
+    explicit RobotEntry(const allocator_type& a) : name(a), idTag(a), causeOfDeath(a) {}
+    // pmr strings keep their own allocator on assignment, so this copies
+    // every field while the strings stay in `a`
+    RobotEntry(const RobotEntry& o, const allocator_type& a) : RobotEntry(a) { *this = o; }
+    RobotEntry(RobotEntry&& o, const allocator_type& a) : RobotEntry(a) { *this = std::move(o); }
+    RobotEntry(const RobotEntry&) = default;
+    RobotEntry(RobotEntry&&) = default;
+    RobotEntry& operator=(const RobotEntry&) = default;
+    RobotEntry& operator=(RobotEntry&&) = default;
+
     RobotBase* bot{};
-    std::string name;
+    SpanRadarRobot* spanRadar{};  // bot's span radar hook, if it has one
+    AnytimeRobot* anytime{};      // bot's anytime turn model, if it has one
+    ForfeitingRobot* forfeit{};   // bot's forfeit flag, if it can give up
+    std::pmr::string name;
     char weaponGlyph{'R'};  // 'R','F','H','G', etc
     char idGlyph{'?'};      // special identifier !@#$%^&*
-    std::string idTag;
+    std::pmr::string idTag;
     int r{0}, c{0};
     bool alive{true};
     int shotsFired{0};
-    int shotsHit{0};
+    int shotsHit{0};        // robots damaged (railgun: struck), one shot may count several
+    int shotsLanded{0};     // shots that did that to at least one robot
     int kills{0};
     int damageDealt{0};
     int damageTaken{0};
@@ -26,33 +70,144 @@ struct RobotEntry {
     int timesStuck  = 0;     
     bool died{false};
     bool trappedInPit = false;
-    std::string causeOfDeath;
+    std::pmr::string causeOfDeath;
+};
+
+
+struct RobotSpawn {
+    RobotBase* bot{};
+    std::string name;
+    char weaponGlyph{'R'};
+};
+
+// Classic prints every turn, the full board and all stats each round.
+// Live publishes frames to a LiveViewer, which draws them on its own clock.
+// Headless prints only the start and the result of each game.
+// Silent prints nothing, for arenas embedded in other programs.
+enum class OutputMode { Classic, Live, Headless, Silent };
+
+// Sequential: each robot sees the moves and hits of those before it in the
+// round. Simultaneous: all robots decide against the same round-start
+// world, then shots and moves are applied in a fixed order. Snapshot: all
+// robots decide against the round-start world, then each robot's action is
+// applied in roster order as in Sequential (robots killed before their
+// slot forfeit). Simultaneous and Snapshot decisions run on the thread
+// pool when one is set.
+enum class TurnMode { Sequential, Simultaneous, Snapshot };
+
+// Inclusive count range for one obstacle type, per 400 cells (a 20x20
+// board); the arena scales it by its own area.
+struct TerrainRange {
+    int min = 0, max = 0;
+    bool valid() const { return min >= 0 && max >= min; }
 };
 
+// What the current game's per-game allocator has handed out since the
+// last reset(), and what that cost the heap.
+struct GameMemory {
+    size_t allocations = 0, bytes = 0;          // asked of the game allocator
+    size_t heapBlocks = 0, heapBytes = 0;       // taken from the heap by it
+};
+
+struct ArenaOptions {
+    int rows = 20, cols = 20;
+    int maxRounds = 0;                 // 0 = only the stalemate rule ends a game
+    uint64_t seed = 0;                 // 0 = seed from std::random_device
+    TerrainRange pits{1, 3};
+    TerrainRange flames{2, 5};
+    TerrainRange mounds{3, 5};
+    TerrainStyle terrain = TerrainStyle::Scattered;
+    TurnMode turns = TurnMode::Sequential;
+    int regionSize = 0;                // >0: partition decision work into regions this wide
+    int repeatLimit = 0;               // >0: stalemate once the world cycles exactly for this many rounds
+    int proofInterval = 16;            // >0: try to prove a stalemate every this many quiet rounds
+    int thinkBudgetUs = 2000;          // an AnytimeRobot's time to decide each turn, in microseconds
+};
 
-class Arena {
+// The arena, templated on its board: Board for any size, or a FixedBoard
+// whose size is compiled in (see Arena and StandardArena below). Members
+// are defined in Arena.cpp and instantiated there for those two.
+template <class BoardT>
+class ArenaT {
 public:
-    Arena(int rows=20,int cols=20);
-    ~Arena();
+    ArenaT(int rows=20,int cols=20);
+    explicit ArenaT(const ArenaOptions& options);
+    ~ArenaT();
+    // Clears robots and terrain and lays out new terrain from `seed`
+    // (0 = random), ready for the next game's robots.
+    void reset(uint64_t seed);
     void addRobot(RobotBase* robot, const std::string& name, char weaponGlyph, int row, int col);
-    void addRobotRandom(RobotBase* robot,
+    // Places the robot on a random free cell not next to another robot.
+    // Fails only when no such cell is left; the robot then stays the caller's.
+    bool addRobotRandom(RobotBase* robot,
                         const std::string& name,
                         char weaponGlyph);
+    // Same for a whole roster, in order. Placement succeeds whenever the
+    // free cells can seat the whole roster, falling back from random
+    // cells to SpawnIndex::pack when needed. The arena owns every robot
+    // passed in; ones that could not be placed are deleted, or go back to
+    // the robot pool when there is one. Returns how many were placed.
+    size_t addRobotsRandom(const std::vector<RobotSpawn>& robots);
+
+    // Plays a whole game at full speed. The same thing one round at a time:
+    // startGame(); while (playRound()) {} finishGame();
+    // finishGame records the game (stats, replay trailer) whenever it
+    // ends, even if cut short, and prints the result unless Silent.
+    void run();
+    void startGame();
+    bool playRound();
+    void finishGame();
+    int  round() const { return m_round; }
+    std::span<const RobotEntry> robots() const { return m_robots; }
 
-    void run(int ms_delay_between_rounds = 100);
+    // Every robot's counters are recorded here when the game ends.
+    void setTournamentStats(TournamentStats* stats) { m_stats = stats; }
+    // Terrain, spawns and every turn of the next run() are recorded here.
+    void setReplayWriter(ReplayWriter* replay) { m_replay = replay; }
+    void setOutputMode(OutputMode mode) { m_output = mode; }
+    // Frames go here in OutputMode::Live; without one, live mode draws nothing.
+    void setViewer(LiveViewer* viewer) { m_viewer = viewer; }
+    // Robot decisions fan out over this pool in the snapshot and simultaneous
+    // turn modes. Robots must then not share mutable state (statics, rand()).
+    // AnytimeRobots also think in the background on it, in every turn mode.
+    void setThreadPool(ThreadPool* pool) { m_pool = pool; m_anytime.setPool(pool); }
+    // Robots go back here instead of being deleted when the arena is reset
+    // or destroyed.
+    void setRobotPool(RobotPool* pool) { m_robotPool = pool; }
+    // The game allocator's counts for the game just played.
+    GameMemory gameMemory() const;
+
+    void captureFrame(ArenaFrame& frame, int round) const;
+    // Copies the current game into `world` (robot i of the roster is robot
+    // i there) for lookahead; reuses its buffers. `seed` drives flame damage.
+    void snapshotWorld(WorldState& world, uint64_t seed = 1) const;
 
 private:
     void seedRandomTerrain();
+    int scaledCount(const TerrainRange& range);
     bool isObstacle(int row, int col) const;      
     bool hasRobot(int row, int col) const;        
     bool hasAdjacentRobot(int row, int col) const;
 
     bool isValidSpawn(int row, int col) const;
-    Board m_board;
-    std::vector<RobotEntry> m_robots;
+    SpawnIndex& spawnIndex();
+    SpawnIndex m_spawns;
+    bool m_spawnsValid = false;    // only maintained while robots are being added
+    ArenaOptions m_options;
+    std::mt19937 m_rng;
+    int  m_nextIdGlyph = 0;
+    BoardT m_board;
+
+    // Everything that lives exactly one game (robot entries and their
+    // strings) is bump-allocated here and dropped in one release() by
+    // reset(). The counters on either side are what gameMemory() reports.
+    CountingResource m_heapSide;                     // what the buffer took from the heap
+    std::pmr::monotonic_buffer_resource m_gameBuffer{&m_heapSide};
+    CountingResource m_gameMemory{&m_gameBuffer};    // what the game asked for
+    std::pmr::vector<RobotEntry> m_robots{&m_gameMemory};
 
     void doTurn(RobotEntry& re);
-    std::vector<RadarObj> scanDirection(const RobotEntry& re, int dir) const;
+    void scanDirection(const RobotEntry& re, int dir, std::vector<RadarObj>& out) const;
     void applyMovement(RobotEntry& re, int dir, int dist);
 
     void resolveShot(const RobotEntry& shooter, int shot_r, int shot_c);
@@ -71,12 +226,85 @@ private:
 
     bool doTurnAndReportAction(RobotEntry& re);
 
+    // One robot's turn split in two: the robot's own calls (radar, shot or
+    // move choice), which only read the world, and the arena applying the
+    // result. Values match ReplayActionKind.
+    enum class TurnAction : uint8_t { None = 0, Shot = 1, Move = 2 };
+    struct TurnDecision {
+        int radarDir = 0;
+        TurnAction action = TurnAction::None;
+        int a = 0, b = 0;          // shot row/col or move dir/dist
+    };
+    bool decideTurn(RobotEntry& re, TurnDecision& d);     // false: robot is dead
+    bool applyTurn(RobotEntry& re, const TurnDecision& d);
+    void decideAll();
+    bool playSimultaneousTurns();
+    bool playSnapshotTurns();
+    ThreadPool* m_pool = nullptr;
+    RobotPool* m_robotPool = nullptr;
+    AnytimeScheduler m_anytime;        // think() coroutines, by robot index
+    void releaseRobots();
+    RegionGrid m_regions;              // living robots by board region, when partitioned
+    std::vector<TurnDecision> m_decisions;
+    std::vector<char> m_decided;
+
+    // Every position change and death goes through these, so the
+    // indexes over robot positions stay in step with m_robots.
+    void moveEntry(RobotEntry& re, int r, int c);
+    void markDead(RobotEntry& re, std::initializer_list<std::string_view> cause);
+    void retireEntry(RobotEntry& re);  // living -> corpse, without the bookkeeping markDead does
+    LineIndex m_lines;                 // living robots by row/col/diagonal
+    LineIndex m_corpses;               // corpses, the same way
+    JumpTable m_jumps;                 // steps to the next terrain or edge; rebuilt with the terrain
+    std::vector<int> m_occupancy;      // cell -> robot index (corpses too), or -1
+    std::vector<int> m_rayHits;        // scratch for railgun and AoE targets
+
+    // Hits every living robot under `shape` at (r0, c0) for `damage`.
+    void applyAreaDamage(RobotEntry& shooter, const AoeShape& shape, int r0, int c0,
+                         int damage, const char* weapon);
+
 
     int rounds_since_action = 0;
     static constexpr int STALEMATE_ROUNDS = 500;
     bool m_damage_or_death_this_round = false;
 
-    std::string boardCellString(int r, int c) const;
+    void boardCellChars(int r, int c, char out[2]) const;
 
     void writeReaperStats(long gameId);
+    void printResult(std::ostream& os) const;     // the end-of-game banner and winners
+    TournamentStats* m_stats = nullptr;
+    ReplayWriter* m_replay = nullptr;
+
+    OutputMode m_output = OutputMode::Classic;
+    bool classicOutput() const { return m_output == OutputMode::Classic; }
+    LiveViewer* m_viewer = nullptr;
+    void publishFrame(bool force);
+
+    int  m_round = 0;
+    long m_gameId = 0;
+    bool m_stalemate = false;
+    enum class StalemateKind { NoDamage, RoundCap, Repeated, Proven };
+    StalemateKind m_stalemateKind = StalemateKind::NoDamage;
+
+    // Positions, health, armor, grenades and alive flags hashed per robot and XORed
+    // together; since health and armor only ever fall, states seen before
+    // the last damage can't come back, so the history is cleared on damage.
+    // The hash leaves out the robots' own state, so one state coming back
+    // proves nothing; only every round repeating the round one period
+    // earlier, repeatLimit rounds in a row, counts as a cycle.
+    void updateStateHash();
+    void trackCycle();
+    std::vector<uint64_t> m_robotKeys;
+    uint64_t m_stateHash = 0;
+    std::vector<uint64_t> m_history;                  // state after each round since the last damage
+    std::unordered_map<uint64_t, int> m_lastSeen;     // state -> its latest index in m_history
+    int m_cyclePeriod = 0;
+    int m_repeats = 0;                 // consecutive rounds matching the round m_cyclePeriod earlier
 };
+
+// Any board size.
+using Arena = ArenaT<Board>;
+// The 20x20 board; pick it when StandardBoard::fits(rows, cols).
+using StandardArena = ArenaT<StandardBoard>;
+extern template class ArenaT<Board>;
+extern template class ArenaT<StandardBoard>;
@@ -0,0 +1,26 @@
+//ArenaFrame.h
+#pragma once
+#include <string>
+#include <vector>
+
+// Plain copy of what a viewer needs to draw one round. Arena::captureFrame
+// refills an existing frame in place so steady-state capture reuses its
+// buffers instead of allocating.
+struct FrameRobot {
+    std::string name;
+    char glyph{'R'};
+    char idGlyph{'?'};
+    int weapon{0};
+    int health{0}, armor{0}, move{0};
+    int r{0}, c{0};
+    bool alive{true};
+};
+
+struct ArenaFrame {
+    int rows{0}, cols{0};
+    int round{0};
+    std::vector<char> cells;          // 2 glyph chars per cell, row-major
+    std::vector<FrameRobot> robots;
+
+    const char* cell(int r, int c) const { return &cells[2 * (static_cast<size_t>(r) * cols + c)]; }
+};
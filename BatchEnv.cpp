@@ -0,0 +1,167 @@
+//BatchEnv.cpp
+#include "BatchEnv.h"
+#include "ResettableRobot.h"
+#include "RobotPool.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <string>
+
+extern "C" RobotBase* create_robot_hammer();
+extern "C" RobotBase* create_robot_sniper();
+
+namespace {
+    // Plays whatever the env put in its action slot and reports its radar
+    // straight into the env's observation row.
+    class ControlledRobot : public RobotBase, public ResettableRobot {
+    public:
+        ControlledRobot() : RobotBase(3, 4, railgun) { m_name = "Agent"; }
+
+        void reset_for_new_game() override {
+            const ControlledRobot fresh;
+            *this = fresh;
+        }
+
+        const BatchAction* action = nullptr;
+        int32_t* obs = nullptr;
+
+        void get_radar_direction(int& dir) override { dir = action->radarDir; }
+
+        void process_radar_results(const std::vector<RadarObj>& hits) override {
+            int n = static_cast<int>(std::min<size_t>(hits.size(), BatchEnv::RADAR_SLOTS));
+            int32_t* slot = obs + BatchEnv::RADAR;
+            for (int i = 0; i < n; ++i) {
+                *slot++ = hits[i].m_type;
+                *slot++ = hits[i].m_row;
+                *slot++ = hits[i].m_col;
+            }
+            std::fill(slot, obs + BatchEnv::OBS_SIZE, 0);
+            obs[BatchEnv::HITS] = n;
+        }
+
+        bool get_shot_location(int& r, int& c) override {
+            if (action->kind != SimActionKind::Shot) return false;
+            r = action->a;
+            c = action->b;
+            return true;
+        }
+
+        void get_move_direction(int& dir, int& dist) override {
+            dir = dist = 0;
+            if (action->kind != SimActionKind::Move) return;
+            dir = action->a;
+            dist = action->b;
+        }
+    };
+
+    RobotBase* create_controlled() { return new ControlledRobot; }
+}
+
+struct BatchEnv::Game {
+    explicit Game(const ArenaOptions& options) : arena(options) {
+        arena.setRobotPool(&robots);
+        arena.setOutputMode(OutputMode::Silent);
+    }
+    RobotPool robots;                  // declared first: the arena returns robots to it
+    Arena arena;
+    ControlledRobot* self = nullptr;
+    int selfIdx = 0;
+    long episode = 0;
+    std::vector<RobotSpawn> roster;
+};
+
+BatchEnv::BatchEnv(const BatchEnvOptions& options, ThreadPool* pool)
+    : m_options(options), m_pool(pool) {
+    const size_t n = static_cast<size_t>(std::max(1, options.games));
+    m_games.reserve(n);
+    for (size_t g = 0; g < n; ++g) m_games.push_back(std::make_unique<Game>(options.arena));
+    m_actions.resize(n);
+    m_obs.assign(n * OBS_SIZE, 0);
+    m_rewards.assign(n, 0.0f);
+    m_done.assign(n, 0);
+    reset();
+}
+
+BatchEnv::~BatchEnv() = default;
+
+void BatchEnv::reset() {
+    for (auto& game : m_games) game->episode = 0;
+    for (int g = 0; g < games(); ++g) {
+        startGame(g);
+        m_rewards[g] = 0.0f;
+        m_done[g] = 0;
+    }
+    m_episodes = 0;
+}
+
+void BatchEnv::startGame(int g) {
+    Game& game = *m_games[g];
+    game.arena.reset(m_options.seed + g + static_cast<uint64_t>(game.episode) * games());
+
+    // the controlled robot goes first on an empty board, so it is always placed
+    game.self = static_cast<ControlledRobot*>(game.robots.acquire(create_controlled));
+    game.self->action = &m_actions[g];
+    game.self->obs = &m_obs[static_cast<size_t>(g) * OBS_SIZE];
+    game.roster.clear();
+    game.roster.push_back({ game.self, "Agent", 'A' });
+    for (int i = 0; i < m_options.snipers; ++i)
+        game.roster.push_back({ game.robots.acquire(create_robot_sniper), "Sniper_" + std::to_string(i + 1), 'R' });
+    for (int i = 0; i < m_options.hammers; ++i)
+        game.roster.push_back({ game.robots.acquire(create_robot_hammer), "Hammer_" + std::to_string(i + 1), 'R' });
+    game.arena.addRobotsRandom(game.roster);
+
+    auto robots = game.arena.robots();
+    game.selfIdx = static_cast<int>(std::find_if(robots.begin(), robots.end(),
+        [&](const RobotEntry& e) { return e.bot == game.self; }) - robots.begin());
+    game.arena.startGame();
+
+    std::fill_n(game.self->obs, OBS_SIZE, 0);
+    observe(g);
+}
+
+void BatchEnv::observe(int g) {
+    const Game& game = *m_games[g];
+    const RobotEntry& me = game.arena.robots()[game.selfIdx];
+    int32_t* row = &m_obs[static_cast<size_t>(g) * OBS_SIZE];
+    row[HEALTH] = me.bot->get_health();
+    row[ARMOR]  = me.bot->get_armor();
+    row[ROW]    = me.r;
+    row[COL]    = me.c;
+}
+
+void BatchEnv::stepGame(int g) {
+    Game& game = *m_games[g];
+    auto robots = game.arena.robots();
+    const RobotEntry& me = robots[game.selfIdx];
+    const int dealt = me.damageDealt, taken = me.damageTaken;
+
+    bool more = game.arena.playRound();
+
+    float reward = static_cast<float>((me.damageDealt - dealt) - (me.damageTaken - taken)) / 100.0f;
+    bool alive = me.alive && me.bot->get_health() > 0;
+    if (more && alive) {
+        m_rewards[g] = reward;
+        m_done[g] = 0;
+        observe(g);
+        return;
+    }
+
+    long others = std::count_if(robots.begin(), robots.end(), [&](const RobotEntry& e) {
+        return &e != &me && e.alive && e.bot->get_health() > 0;
+    });
+    if (!alive) reward -= 1.0f;
+    else if (others == 0) reward += 1.0f;
+    m_rewards[g] = reward;
+    m_done[g] = 1;
+    game.arena.finishGame();        // the episode is over even if the game isn't
+    ++game.episode;
+    startGame(g);
+}
+
+void BatchEnv::step() {
+    if (m_pool) {
+        m_pool->parallelFor(m_games.size(), [this](size_t g) { stepGame(static_cast<int>(g)); });
+    } else {
+        for (int g = 0; g < games(); ++g) stepGame(g);
+    }
+    m_episodes += std::count(m_done.begin(), m_done.end(), 1);
+}
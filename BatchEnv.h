@@ -0,0 +1,91 @@
+//BatchEnv.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Arena.h"
+#include "WorldState.h"
+
+class ThreadPool;
+
+// Many small headless games stepped in lockstep, for training agents.
+// Each game has one controlled robot (a railgun, move 3, armor 4, like
+// Robot_Sniper) whose turns come from the action buffer, plus scripted
+// Sniper and Hammer opponents that play themselves. A step plays one full
+// round of every game; a game that ends is reset from its next seed in
+// the same step and flagged in done().
+//
+// Buffers are allocated once. The controlled robot writes its radar hits
+// straight into its game's observation row and the env fills in the rest,
+// so observations() and rewards() can be read in place between steps.
+// The opponents draw from rand(), so runs on a pool are not reproducible.
+
+struct BatchEnvOptions {
+    int games = 64;
+    ArenaOptions arena = [] {
+        ArenaOptions a;
+        a.maxRounds = 200;
+        return a;
+    }();
+    int snipers = 1;
+    int hammers = 1;
+    uint64_t seed = 1;                 // game g starts from seed + g
+};
+
+struct BatchAction {
+    int radarDir = 1;                  // 1..8, scanned before acting
+    SimActionKind kind = SimActionKind::None;
+    int a = 0, b = 0;                  // shot row/col, or move direction/distance
+};
+
+class BatchEnv {
+public:
+    // Observation row, all int32:
+    //   [HEALTH, ARMOR, ROW, COL, HITS, then RADAR_SLOTS x (type, row, col)]
+    // where type is RadarObj::m_type ('R', 'X', 'M', 'P', 'F', ...) and
+    // unused slots are zero. HITS counts the slots filled.
+    enum : int { HEALTH, ARMOR, ROW, COL, HITS, RADAR };
+    static constexpr int RADAR_SLOTS = 20;
+    static constexpr int OBS_SIZE = RADAR + 3 * RADAR_SLOTS;
+
+    explicit BatchEnv(const BatchEnvOptions& options, ThreadPool* pool = nullptr);
+    ~BatchEnv();
+    BatchEnv(const BatchEnv&) = delete;
+    BatchEnv& operator=(const BatchEnv&) = delete;
+
+    int games() const { return static_cast<int>(m_games.size()); }
+
+    // Starts every game over from its first seed.
+    void reset();
+    // Plays one round of every game with actions()[g] for game g.
+    void step();
+
+    std::span<BatchAction> actions() { return m_actions; }
+    // games() * OBS_SIZE, row g for game g.
+    std::span<const int32_t> observations() const { return m_obs; }
+    std::span<const int32_t> observation(int g) const {
+        return std::span<const int32_t>(m_obs).subspan(static_cast<size_t>(g) * OBS_SIZE, OBS_SIZE);
+    }
+    // Damage dealt minus damage taken this step, /100, plus 1 for
+    // winning or -1 for dying.
+    std::span<const float> rewards() const { return m_rewards; }
+    // 1 where the game ended this step (the observation is already the new game's).
+    std::span<const uint8_t> done() const { return m_done; }
+    long episodes() const { return m_episodes; }
+
+private:
+    struct Game;
+    void startGame(int g);
+    void stepGame(int g);
+    void observe(int g);
+
+    BatchEnvOptions m_options;
+    ThreadPool* m_pool;
+    std::vector<std::unique_ptr<Game>> m_games;
+    std::vector<BatchAction> m_actions;
+    std::vector<int32_t> m_obs;
+    std::vector<float> m_rewards;
+    std::vector<uint8_t> m_done;
+    long m_episodes = 0;
+};
@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <stdexcept>
 #include <vector>
 #include "Tile.h"
 class Board {
@@ -7,10 +10,45 @@ public:
     int rows() const{return m_rows;}
     int cols() const{return m_cols;}
     bool inBounds(int r,int c) const{return r>=0 && c>=0 && r<m_rows && c<m_cols;}
-    Tile get(int r,int c) const{return m_grid[r][c];}
-    void set(int r,int c,Tile t){m_grid[r][c]=t;}
-    // simple default layout: border is empty; a few interior features
-    void seedDefaultFeatures();
+    Tile get(int r,int c) const{return m_grid[index(r,c)];}
+    void set(int r,int c,Tile t){m_grid[index(r,c)]=t;}
+    // flat row-major storage: cell id = r*cols + c
+    int index(int r,int c) const{return r*m_cols+c;}
+    int size() const{return m_rows*m_cols;}
+    Tile at(int cell) const{return m_grid[cell];}
+    void setAt(int cell,Tile t){m_grid[cell]=t;}
+    void clear(){std::fill(m_grid.begin(),m_grid.end(),Tile::Empty);}
 private:
     int m_rows,m_cols;
-    std::vector<std::vector<Tile>> m_grid;};
+    std::vector<Tile> m_grid;};
+
+// Board with its size fixed at compile time: the same interface, but the
+// tiles sit inline in the object and rows, cols, bounds and cell ids are
+// constants, so neighbourhood loops over it fold and unroll. Code that
+// works on either board is a template explicitly instantiated for Board
+// and StandardBoard; a new fixed size needs adding to those lists.
+template <int R, int C>
+class FixedBoard {
+public:
+    static_assert(R > 0 && C > 0, "a board needs at least one cell");
+    static constexpr bool fits(int rows,int cols){return rows==R && cols==C;}
+
+    FixedBoard(int rows=R,int cols=C){
+        if (!fits(rows,cols)) throw std::invalid_argument("board size does not match FixedBoard");
+        clear();}
+    static constexpr int rows(){return R;}
+    static constexpr int cols(){return C;}
+    static constexpr bool inBounds(int r,int c){
+        return static_cast<unsigned>(r)<static_cast<unsigned>(R) && static_cast<unsigned>(c)<static_cast<unsigned>(C);}
+    Tile get(int r,int c) const{return m_grid[index(r,c)];}
+    void set(int r,int c,Tile t){m_grid[index(r,c)]=t;}
+    static constexpr int index(int r,int c){return r*C+c;}
+    static constexpr int size(){return R*C;}
+    Tile at(int cell) const{return m_grid[cell];}
+    void setAt(int cell,Tile t){m_grid[cell]=t;}
+    void clear(){m_grid.fill(Tile::Empty);}
+private:
+    std::array<Tile,R*C> m_grid;};
+
+// The size nearly every game is played at.
+using StandardBoard = FixedBoard<20,20>;
@@ -0,0 +1,114 @@
+//Config.cpp
+#include "Config.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+    std::string trim(const std::string& s) {
+        size_t b = s.find_first_not_of(" \t\r");
+        if (b == std::string::npos) return "";
+        size_t e = s.find_last_not_of(" \t\r");
+        return s.substr(b, e - b + 1);
+    }
+
+    // Reads exactly the listed ints from `value`; anything left over is an error.
+    template <typename... Ints>
+    bool readInts(const std::string& value, Ints&... out) {
+        std::istringstream in(value);
+        bool ok = static_cast<bool>((in >> ... >> out));
+        std::string rest;
+        return ok && !(in >> rest);
+    }
+}
+
+bool loadConfig(const std::string& path, Config& cfg, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = path + ": cannot open";
+        return false;
+    }
+
+    std::string line;
+    int lineNo = 0;
+    auto fail = [&](const std::string& msg) {
+        error = path + ":" + std::to_string(lineNo) + ": " + msg;
+        return false;
+    };
+
+    ArenaOptions& a = cfg.arena;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) return fail("expected key = value");
+        std::string key   = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+
+        bool ok = true;
+        if      (key == "rows")       ok = readInts(value, a.rows) && a.rows >= 10;
+        else if (key == "cols")       ok = readInts(value, a.cols) && a.cols >= 10;
+        else if (key == "games")      ok = readInts(value, cfg.games) && cfg.games >= 1;
+        else if (key == "max_rounds") ok = readInts(value, a.maxRounds) && a.maxRounds >= 0;
+        else if (key == "fps")        ok = readInts(value, cfg.fps) && cfg.fps >= 1;
+        else if (key == "repeat_limit")    ok = readInts(value, a.repeatLimit) && a.repeatLimit >= 0;
+        else if (key == "stalemate_proof") ok = readInts(value, a.proofInterval) && a.proofInterval >= 0;
+        else if (key == "think_budget") ok = readInts(value, a.thinkBudgetUs) && a.thinkBudgetUs >= 1;
+        else if (key == "region_size") ok = readInts(value, a.regionSize) && a.regionSize >= 0;
+        else if (key == "threads")    ok = readInts(value, cfg.threads) && cfg.threads >= 0;
+        else if (key == "sandbox_timeout") ok = readInts(value, cfg.sandboxTimeoutMs) && cfg.sandboxTimeoutMs >= 1;
+        else if (key == "seed") {
+            std::istringstream v(value);
+            ok = static_cast<bool>(v >> a.seed);
+        }
+        else if (key == "pits")   ok = readInts(value, a.pits.min,   a.pits.max)   && a.pits.valid();
+        else if (key == "flames") ok = readInts(value, a.flames.min, a.flames.max) && a.flames.valid();
+        else if (key == "mounds") ok = readInts(value, a.mounds.min, a.mounds.max) && a.mounds.valid();
+        else if (key == "replay") cfg.replayPrefix = value;
+        else if (key == "output") {
+            if      (value == "classic")  cfg.output = OutputMode::Classic;
+            else if (value == "live")     cfg.output = OutputMode::Live;
+            else if (value == "headless") cfg.output = OutputMode::Headless;
+            else return fail("output must be classic, live or headless");
+        }
+        else if (key == "sandbox") {
+            if      (value == "on")  cfg.sandbox = true;
+            else if (value == "off") cfg.sandbox = false;
+            else return fail("sandbox must be on or off");
+        }
+        else if (key == "memory_report") {
+            if      (value == "on")  cfg.memoryReport = true;
+            else if (value == "off") cfg.memoryReport = false;
+            else return fail("memory_report must be on or off");
+        }
+        else if (key == "terrain") {
+            if      (value == "scattered") a.terrain = TerrainStyle::Scattered;
+            else if (value == "walls")     a.terrain = TerrainStyle::Walls;
+            else if (value == "corridors") a.terrain = TerrainStyle::Corridors;
+            else return fail("terrain must be scattered, walls or corridors");
+        }
+        else if (key == "turns") {
+            if      (value == "sequential")   a.turns = TurnMode::Sequential;
+            else if (value == "simultaneous") a.turns = TurnMode::Simultaneous;
+            else if (value == "snapshot")     a.turns = TurnMode::Snapshot;
+            else return fail("turns must be sequential, simultaneous or snapshot");
+        }
+        else if (key == "robot") {
+            RosterEntry r;
+            std::string symbol, rest;
+            std::istringstream v(value);
+            if (!(v >> r.type >> symbol >> r.count) || symbol.size() != 1
+                || r.count < 0 || (v >> rest))
+                return fail("expected robot = <type> <symbol> <count>");
+            r.symbol = symbol[0];
+            cfg.roster.push_back(r);
+        }
+        else return fail("unknown key '" + key + "'");
+
+        if (!ok) return fail("bad value for " + key + ": '" + value + "'");
+    }
+    return true;
+}
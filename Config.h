@@ -0,0 +1,54 @@
+//Config.h
+#pragma once
+#include <string>
+#include <vector>
+#include "Arena.h"
+
+// One roster line: `robot = <type> <symbol> <count>`. The type must be a
+// name main() has a factory for (Reaper, Flame, Rat, ...).
+struct RosterEntry {
+    std::string type;
+    char symbol = 'R';
+    int count = 1;
+};
+
+// Everything a tournament run needs, read once at startup. Missing keys
+// keep the defaults below, which match the original hard-coded 20x20 game.
+//
+//   # comment
+//   rows = 500
+//   cols = 500
+//   games = 10
+//   max_rounds = 5000          # 0 = no cap beyond the stalemate rule
+//   output = headless          # classic | live | headless
+//   fps = 30
+//   seed = 42                  # 0 = random each run
+//   pits = 1 3                 # min max per 400 cells, scaled by board area
+//   flames = 2 5
+//   mounds = 3 5
+//   terrain = walls            # scattered | walls | corridors
+//   turns = snapshot           # sequential | simultaneous | snapshot
+//   threads = 8                # decision workers for simultaneous/snapshot; 0 = all cores, 1 = none
+//   region_size = 128          # with threads: one decision task per 128x128 region; 0 = off
+//   think_budget = 2000        # microseconds an anytime robot (Planner) gets per turn
+//   replay = games/run         # writes games/run_<n>.rwr
+//   sandbox = on               # each robot in its own worker process
+//   sandbox_timeout = 1000     # ms a sandboxed robot gets per call before it forfeits
+//   memory_report = on         # print the game allocator's counts after each game
+//   robot = Sniper R 200
+struct Config {
+    int games = 1;
+    OutputMode output = OutputMode::Classic;
+    int fps = 30;
+    int threads = 1;
+    bool sandbox = false;
+    int sandboxTimeoutMs = 1000;
+    bool memoryReport = false;
+    std::string replayPrefix;
+    ArenaOptions arena;
+    std::vector<RosterEntry> roster;   // empty = the built-in roster
+};
+
+// Parses `path` into `cfg`, leaving unset keys alone. On failure returns
+// false with a "file:line: message" in `error`.
+bool loadConfig(const std::string& path, Config& cfg, std::string& error);
@@ -0,0 +1,38 @@
+//CountingResource.h
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+// Pass-through memory_resource that counts what goes through it. Stacked
+// on both sides of a monotonic buffer it shows how much a game asked for
+// and how much actually came from the heap.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : m_upstream(upstream) {}
+
+    size_t allocations() const { return m_allocs; }
+    size_t bytes()       const { return m_bytes; }      // total requested
+    size_t peak()        const { return m_peak; }       // most live at once
+    void resetCounts() { m_allocs = m_bytes = m_live = m_peak = 0; }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        void* p = m_upstream->allocate(bytes, align);
+        ++m_allocs;
+        m_bytes += bytes;
+        m_live  += bytes;
+        if (m_live > m_peak) m_peak = m_live;
+        return p;
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        m_upstream->deallocate(p, bytes, align);
+        m_live -= bytes;
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_allocs = 0, m_bytes = 0, m_live = 0, m_peak = 0;
+};
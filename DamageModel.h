@@ -8,6 +8,11 @@ namespace DM {
     constexpr int GrenadeDamage=18;     // AoE; not implemented in v1
     constexpr int HammerDamage =30;     // adjacent; not implemented in v1
     constexpr int CollisionDamage=10;
+    constexpr int FlameTileMin=30,FlameTileMax=50;  // stepping onto a flame tile
+    // Weapon reach:
+    constexpr int FlameRange=4,FlameHalfWidth=1;    // cone out from the shooter
+    constexpr int GrenadeRange=6;                   // Manhattan distance of the throw
+    constexpr int GrenadeBlastRadius=1;
 
     inline int applyArmorThenDegrade(RobotBase& target,int base){
         int a=target.get_armor();
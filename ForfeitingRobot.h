@@ -0,0 +1,17 @@
+//ForfeitingRobot.h
+#pragma once
+
+// Opt-in hook for robots that can give up mid-game, as a SandboxedRobot
+// does when its worker crashes or hangs. The robot only raises the flag
+// while it decides; the arena applies the forfeit (health to 0, death
+// recorded) when it applies that robot's turn, so nothing about the world
+// changes during the decide phase. Found with dynamic_cast, like
+// ResettableRobot.
+class ForfeitingRobot {
+public:
+    // True from the moment the robot gave up until it is reset for a new game.
+    virtual bool forfeited() const = 0;
+
+protected:
+    ~ForfeitingRobot() = default;
+};
@@ -0,0 +1,29 @@
+//JumpTable.cpp
+#include "JumpTable.h"
+#include "RobotBase.h"
+#include <algorithm>
+
+template <class BoardT>
+void JumpTable::build(const BoardT& board) {
+    const int rows = board.rows(), cols = board.cols();
+    m_next.resize(static_cast<size_t>(rows) * cols * 8);
+
+    for (int dir = 1; dir <= 8; ++dir) {
+        const int dr = directions[dir].first, dc = directions[dir].second;
+        // visit each cell after the cell it steps onto, so that one is done
+        const int r0 = dr > 0 ? rows - 1 : 0, rEnd = dr > 0 ? -1 : rows, rStep = dr > 0 ? -1 : 1;
+        const int c0 = dc > 0 ? cols - 1 : 0, cEnd = dc > 0 ? -1 : cols, cStep = dc > 0 ? -1 : 1;
+        for (int r = r0; r != rEnd; r += rStep) {
+            for (int c = c0; c != cEnd; c += cStep) {
+                int nr = r + dr, nc = c + dc;
+                int steps = 1;
+                if (board.inBounds(nr, nc) && board.get(nr, nc) == Tile::Empty)
+                    steps = std::min(MAX_JUMP, next(board.index(nr, nc), dir) + 1);
+                m_next[static_cast<size_t>(board.index(r, c)) * 8 + dir - 1] = static_cast<uint8_t>(steps);
+            }
+        }
+    }
+}
+
+template void JumpTable::build(const Board&);
+template void JumpTable::build(const StandardBoard&);
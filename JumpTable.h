@@ -0,0 +1,25 @@
+//JumpTable.h
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+
+// For every cell and each of the 8 directions, how many steps it is to the
+// first cell that is not plain floor: terrain (mound, pit, flame) or off
+// the board. Everything closer is known to be in bounds and Tile::Empty, so
+// movement and rays can skip over it without looking at the board.
+// Distances saturate at MAX_JUMP; a cell that far out may be floor too, in
+// which case the caller looks it up and jumps again from there.
+// Built from the terrain, so rebuild whenever the terrain changes.
+class JumpTable {
+public:
+    static constexpr int MAX_JUMP = 255;
+
+    template <class BoardT>
+    void build(const BoardT& board);
+    // Steps from `cell` in direction `dir` (1..8) to the next non-floor cell.
+    int next(int cell, int dir) const { return m_next[static_cast<size_t>(cell) * 8 + dir - 1]; }
+
+private:
+    std::vector<uint8_t> m_next;     // cell*8 + dir-1
+};
@@ -0,0 +1,29 @@
+//LineIndex.cpp
+#include "LineIndex.h"
+
+void LineIndex::reset(int rows, int cols) {
+    m_cols = cols;
+    m_lines[Row].assign(rows, {});
+    m_lines[Col].assign(cols, {});
+    m_lines[Diag].assign(rows + cols - 1, {});
+    m_lines[Anti].assign(rows + cols - 1, {});
+}
+
+void LineIndex::insert(int idx, int r, int c) {
+    for (int fam = 0; fam < FamilyCount; ++fam) {
+        auto& line = m_lines[fam][lineOf(fam, r, c)];
+        int key = keyOf(fam, r, c);
+        auto it = std::lower_bound(line.begin(), line.end(), key,
+            [&](const Occupant& o, int k) { return keyOf(fam, o.r, o.c) < k; });
+        line.insert(it, Occupant{idx, r, c});
+    }
+}
+
+void LineIndex::remove(int idx, int r, int c) {
+    for (int fam = 0; fam < FamilyCount; ++fam) {
+        auto& line = m_lines[fam][lineOf(fam, r, c)];
+        auto it = std::find_if(line.begin(), line.end(),
+            [&](const Occupant& o) { return o.idx == idx; });
+        if (it != line.end()) line.erase(it);
+    }
+}
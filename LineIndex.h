@@ -0,0 +1,59 @@
+//LineIndex.h
+#pragma once
+#include <algorithm>
+#include <vector>
+
+// Living robots grouped by every row, column, diagonal (r-c constant) and
+// anti-diagonal (r+c constant) they stand on. Each line is kept sorted by
+// position along it, so the robots a straight shot passes are a contiguous
+// run that can be walked in ray order without touching empty cells.
+class LineIndex {
+public:
+    struct Occupant { int idx; int r, c; };
+
+    void reset(int rows, int cols);
+    void insert(int idx, int r, int c);
+    void remove(int idx, int r, int c);
+
+    // Calls f(const Occupant&) for every robot on the ray that starts just
+    // past (r, c) and steps (dr, dc), nearest first. (dr, dc) must be one
+    // of the 8 unit directions.
+    template <typename F>
+    void forEachOnRay(int r, int c, int dr, int dc, F&& f) const {
+        int fam = family(dr, dc);
+        const auto& line = m_lines[fam][lineOf(fam, r, c)];
+        int key = keyOf(fam, r, c);
+        int step = (fam == Row) ? dc : dr;
+        if (step > 0) {
+            auto it = std::upper_bound(line.begin(), line.end(), key,
+                [&](int k, const Occupant& o) { return k < keyOf(fam, o.r, o.c); });
+            for (; it != line.end(); ++it) f(*it);
+        } else {
+            auto it = std::lower_bound(line.begin(), line.end(), key,
+                [&](const Occupant& o, int k) { return keyOf(fam, o.r, o.c) < k; });
+            while (it != line.begin()) f(*--it);
+        }
+    }
+
+private:
+    enum Family { Row, Col, Diag, Anti, FamilyCount };
+
+    static int family(int dr, int dc) {
+        if (dr == 0) return Row;
+        if (dc == 0) return Col;
+        return (dr == dc) ? Diag : Anti;
+    }
+    int lineOf(int fam, int r, int c) const {
+        switch (fam) {
+            case Row:  return r;
+            case Col:  return c;
+            case Diag: return r - c + m_cols - 1;
+            default:   return r + c;
+        }
+    }
+    // position along the line; rows are ordered by column, the rest by row
+    static int keyOf(int fam, int r, int c) { return fam == Row ? c : r; }
+
+    int m_cols = 0;
+    std::vector<std::vector<Occupant>> m_lines[FamilyCount];
+};
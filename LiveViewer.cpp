@@ -0,0 +1,64 @@
+//LiveViewer.cpp
+#include "LiveViewer.h"
+#include <algorithm>
+#include <utility>
+
+LiveViewer::LiveViewer(int fps, int fd)
+    : m_renderer(fd),
+      m_period(std::chrono::microseconds(1'000'000 / std::clamp(fps, 1, 1000)))
+{
+    m_thread = std::thread(&LiveViewer::loop, this);
+}
+
+LiveViewer::~LiveViewer() {
+    {
+        std::lock_guard<std::mutex> lk(m_stopMutex);
+        m_stop = true;
+    }
+    m_stopCv.notify_all();
+    m_thread.join();
+}
+
+void LiveViewer::publish() {
+    std::lock_guard<std::mutex> lk(m_swapMutex);
+    std::swap(m_back, m_pending);
+    m_fresh.store(true, std::memory_order_release);
+}
+
+bool LiveViewer::takePending() {
+    std::lock_guard<std::mutex> lk(m_swapMutex);
+    if (!m_fresh.load(std::memory_order_relaxed)) return false;
+    std::swap(m_pending, m_front);
+    m_fresh.store(false, std::memory_order_release);
+    return true;
+}
+
+void LiveViewer::drain() {
+    std::lock_guard<std::mutex> lk(m_renderMutex);
+    if (takePending()) m_renderer.render(*m_front);
+}
+
+void LiveViewer::invalidate() {
+    std::lock_guard<std::mutex> lk(m_renderMutex);
+    m_renderer.invalidate();
+}
+
+void LiveViewer::loop() {
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> stopLock(m_stopMutex);
+    while (!m_stop) {
+        next += m_period;
+        if (m_stopCv.wait_until(stopLock, next, [this] { return m_stop; })) break;
+
+        stopLock.unlock();
+        {
+            std::lock_guard<std::mutex> lk(m_renderMutex);
+            if (takePending()) m_renderer.render(*m_front);
+        }
+        stopLock.lock();
+
+        // fell behind (slow terminal): skip ticks instead of bursting
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) next = now;
+    }
+}
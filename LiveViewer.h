@@ -0,0 +1,52 @@
+//LiveViewer.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "ArenaFrame.h"
+#include "TerminalRenderer.h"
+
+// Renders published frames on its own thread at a fixed frame rate, so the
+// simulation never waits on the terminal. Frames are triple-buffered: the
+// simulation fills back(), publish() swaps it with the pending frame, and
+// each tick the viewer swaps pending into its front buffer and draws it.
+// Rounds published between two ticks are simply replaced (dropped).
+class LiveViewer {
+public:
+    explicit LiveViewer(int fps = 30, int fd = 1);
+    ~LiveViewer();
+    LiveViewer(const LiveViewer&) = delete;
+    LiveViewer& operator=(const LiveViewer&) = delete;
+
+    // True once the viewer has taken the last published frame; capturing
+    // a new one before that would be wasted work.
+    bool wantsFrame() const { return !m_fresh.load(std::memory_order_acquire); }
+    // Simulation-side buffer to capture into before publish().
+    ArenaFrame& back() { return *m_back; }
+    void publish();
+    // Draws the newest published frame now, on the calling thread. Used at
+    // game end so the final board is on screen before any text follows it.
+    void drain();
+    // Next frame is a full redraw (e.g. after other output hit the terminal).
+    void invalidate();
+
+private:
+    void loop();
+    bool takePending();    // requires m_renderMutex
+
+    ArenaFrame m_frames[3];
+    ArenaFrame* m_back    = &m_frames[0];
+    ArenaFrame* m_pending = &m_frames[1];
+    ArenaFrame* m_front   = &m_frames[2];
+    std::atomic<bool> m_fresh{false};
+    std::mutex m_swapMutex;         // guards m_pending / m_fresh swaps
+    std::mutex m_renderMutex;       // guards m_front and m_renderer
+    TerminalRenderer m_renderer;
+
+    std::chrono::microseconds m_period;
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCv;
+    bool m_stop = false;
+    std::thread m_thread;
+};
@@ -0,0 +1,15 @@
+//RegionGrid.cpp
+#include "RegionGrid.h"
+
+void RegionGrid::reset(int rows, int cols, int regionSize) {
+    m_size = regionSize;
+    m_robots.clear();
+    m_incoming.clear();
+    if (regionSize <= 0) {
+        m_regionCols = 0;
+        return;
+    }
+    int regionRows = (rows + regionSize - 1) / regionSize;
+    m_regionCols = (cols + regionSize - 1) / regionSize;
+    m_robots.resize(static_cast<size_t>(regionRows) * m_regionCols);
+}
@@ -0,0 +1,51 @@
+//RegionGrid.h
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Splits the board into square regions and keeps, per region, the living
+// robots standing in it as of the last round barrier. Regions are the unit
+// of parallel work on very large boards: one task per region keeps each
+// worker on one neighbourhood of the board and one slice of the robots.
+// Robots that crossed a border during a round change hands in migrate().
+class RegionGrid {
+public:
+    void reset(int rows, int cols, int regionSize);
+    bool active() const { return m_size > 0; }
+    int  count() const { return static_cast<int>(m_robots.size()); }
+    int  regionOf(int r, int c) const { return (r / m_size) * m_regionCols + c / m_size; }
+
+    const std::vector<int>& robots(int region) const { return m_robots[region]; }
+    void insert(int idx, int r, int c) { m_robots[regionOf(r, c)].push_back(idx); }
+
+    // Round barrier: drops robots for which alive(idx) is false and moves
+    // the rest to the region their position(idx, r, c) now lies in.
+    // Returns how many robots changed region.
+    template <typename Alive, typename Position>
+    int migrate(Alive&& alive, Position&& position) {
+        int moved = 0;
+        for (int g = 0; g < count(); ++g) {
+            auto& list = m_robots[g];
+            for (size_t i = 0; i < list.size();) {
+                int idx = list[i];
+                int r = 0, c = 0;
+                position(idx, r, c);
+                int to = alive(idx) ? regionOf(r, c) : -1;
+                if (to == g) { ++i; continue; }
+                if (to >= 0) { m_incoming.emplace_back(to, idx); ++moved; }
+                list[i] = list.back();
+                list.pop_back();
+            }
+        }
+        for (const auto& [to, idx] : m_incoming) m_robots[to].push_back(idx);
+        m_incoming.clear();
+        return moved;
+    }
+
+private:
+    int m_size = 0;
+    int m_regionCols = 0;
+    std::vector<std::vector<int>> m_robots;
+    std::vector<std::pair<int, int>> m_incoming;    // (region, robot) during migrate
+};
@@ -0,0 +1,415 @@
+//Replay.cpp
+#include "Replay.h"
+#include "Arena.h"
+#include "Board.h"
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+
+namespace {
+    constexpr char MAGIC[4]   = {'R','W','R','1'};
+    constexpr char TRAILER[4] = {'R','W','R','I'};
+
+    enum : uint8_t { BLK_KEYFRAME = 'K', BLK_ROUND = 'R', BLK_END = 'E', BLK_INDEX = 'I' };
+    enum : uint8_t { F_ALIVE = 1, F_TRAPPED = 2 };
+    enum : uint8_t { D_POS = 1, D_HEALTH = 2, D_ARMOR = 4, D_GRENADES = 8, D_FLAGS = 16 };
+}
+
+// ---------------------------------------------------------------- writer
+
+ReplayWriter::ReplayWriter(const std::string& path, int keyframeInterval)
+    : m_out(path, std::ios::binary | std::ios::trunc),
+      m_keyframeInterval(std::max(1, keyframeInterval))
+{
+    m_buf.reserve(1 << 16);
+}
+
+// An unfinished replay has no trailer; ReplayReader rebuilds the index by scanning.
+ReplayWriter::~ReplayWriter() {
+    flush(true);
+}
+
+void ReplayWriter::putVar(uint64_t v) {
+    while (v >= 0x80) { putByte(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+    putByte(static_cast<uint8_t>(v));
+}
+
+void ReplayWriter::putSigned(int64_t v) {
+    putVar((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+void ReplayWriter::putFixed64(uint64_t v) {
+    for (int i = 0; i < 8; ++i) putByte(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void ReplayWriter::flush(bool force) {
+    if (!m_out || (!force && m_buf.size() < (1u << 16))) return;
+    m_out.write(m_buf.data(), static_cast<std::streamsize>(m_buf.size()));
+    m_flushed += m_buf.size();
+    m_buf.clear();
+    if (force) m_out.flush();
+}
+
+ReplayWriter::Cached ReplayWriter::capture(const RobotEntry& re) {
+    Cached c;
+    c.r = re.r;
+    c.c = re.c;
+    c.health = re.bot->get_health();
+    c.armor = re.bot->get_armor();
+    c.grenades = re.bot->get_grenades();
+    c.flags = static_cast<uint8_t>(((re.alive && c.health > 0) ? F_ALIVE : 0) |
+                                   (re.trappedInPit ? F_TRAPPED : 0));
+    return c;
+}
+
+template <class BoardT>
+void ReplayWriter::begin(const BoardT& board, std::span<const RobotEntry> robots) {
+    m_buf.append(MAGIC, sizeof(MAGIC));
+    putVar(board.rows());
+    putVar(board.cols());
+    putVar(m_keyframeInterval);
+
+    // terrain: non-empty cells as (gap, tile)
+    std::vector<std::pair<int, Tile>> cells;
+    for (int r = 0; r < board.rows(); ++r)
+        for (int c = 0; c < board.cols(); ++c)
+            if (board.get(r, c) != Tile::Empty) cells.push_back({r * board.cols() + c, board.get(r, c)});
+    putVar(cells.size());
+    int prev = 0;
+    for (auto [idx, t] : cells) {
+        putVar(idx - prev);
+        putByte(static_cast<uint8_t>(t));
+        prev = idx;
+    }
+
+    // spawns
+    putVar(robots.size());
+    m_state.clear();
+    for (const auto& re : robots) {
+        putVar(re.name.size());
+        m_buf.append(re.name);
+        putByte(static_cast<uint8_t>(re.weaponGlyph));
+        putByte(static_cast<uint8_t>(re.idGlyph));
+        putByte(static_cast<uint8_t>(re.bot->get_weapon()));
+        putVar(re.bot->get_move_speed());
+        m_state.push_back(capture(re));
+    }
+    writeKeyframe(0);
+}
+
+template void ReplayWriter::begin(const Board&, std::span<const RobotEntry>);
+template void ReplayWriter::begin(const StandardBoard&, std::span<const RobotEntry>);
+
+void ReplayWriter::writeKeyframe(int round) {
+    m_index.push_back({round, offset()});
+    putByte(BLK_KEYFRAME);
+    putVar(round);
+    for (const auto& s : m_state) {
+        putVar(s.r);
+        putVar(s.c);
+        putVar(s.health);
+        putVar(s.armor);
+        putVar(s.grenades);
+        putByte(s.flags);
+    }
+}
+
+void ReplayWriter::action(int robot, int radarDir, ReplayActionKind kind, int a, int b) {
+    m_actions.push_back({robot, radarDir, kind, a, b});
+}
+
+void ReplayWriter::endRound(int round, std::span<const RobotEntry> robots) {
+    putByte(BLK_ROUND);
+    putVar(round);
+
+    putVar(m_actions.size());
+    for (const auto& a : m_actions) {
+        putVar(a.robot);
+        putByte(static_cast<uint8_t>(a.radarDir));
+        putByte(static_cast<uint8_t>(a.kind));
+        if (a.kind != ReplayActionKind::None) {
+            putSigned(a.a);
+            putSigned(a.b);
+        }
+    }
+    m_actions.clear();
+
+    // deltas against the previous round's state
+    m_changed.clear();
+    for (size_t i = 0; i < robots.size() && i < m_state.size(); ++i) {
+        Cached now = capture(robots[i]);
+        const Cached& old = m_state[i];
+        uint8_t mask = 0;
+        if (now.r != old.r || now.c != old.c) mask |= D_POS;
+        if (now.health != old.health)         mask |= D_HEALTH;
+        if (now.armor != old.armor)           mask |= D_ARMOR;
+        if (now.grenades != old.grenades)     mask |= D_GRENADES;
+        if (now.flags != old.flags)           mask |= D_FLAGS;
+        if (mask) m_changed.push_back({i, mask});
+        m_state[i] = now;
+    }
+    putVar(m_changed.size());
+    for (auto [i, mask] : m_changed) {
+        const Cached& now = m_state[i];
+        putVar(i);
+        putByte(mask);
+        if (mask & D_POS)      { putVar(now.r); putVar(now.c); }
+        if (mask & D_HEALTH)   putVar(now.health);
+        if (mask & D_ARMOR)    putVar(now.armor);
+        if (mask & D_GRENADES) putVar(now.grenades);
+        if (mask & D_FLAGS)    putByte(now.flags);
+    }
+
+    if (round % m_keyframeInterval == 0) writeKeyframe(round);
+    flush();
+}
+
+void ReplayWriter::finish(int rounds, bool stalemate) {
+    if (m_finished) return;
+    m_finished = true;
+    putByte(BLK_END);
+    putVar(rounds);
+    putByte(stalemate ? 1 : 0);
+
+    uint64_t indexAt = offset();
+    putByte(BLK_INDEX);
+    putVar(rounds);
+    putByte(stalemate ? 1 : 0);
+    putVar(m_index.size());
+    for (auto [round, off] : m_index) {
+        putVar(round);
+        putFixed64(off);
+    }
+    putFixed64(indexAt);
+    m_buf.append(TRAILER, sizeof(TRAILER));
+    flush(true);
+}
+
+// ---------------------------------------------------------------- reader
+
+uint64_t ReplayReader::getVar(size_t& pos) const {
+    uint64_t v = 0;
+    int shift = 0;
+    while (pos < m_data.size() && shift < 64) {
+        uint8_t b = static_cast<uint8_t>(m_data[pos++]);
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+        shift += 7;
+    }
+    return v;
+}
+
+int64_t ReplayReader::getSigned(size_t& pos) const {
+    uint64_t z = getVar(pos);
+    return static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+}
+
+bool ReplayReader::open(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { m_error = "cannot open " + path; return false; }
+    m_data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    if (m_data.size() < sizeof(MAGIC) || !std::equal(MAGIC, MAGIC + 4, m_data.begin())) {
+        m_error = path + " is not a RobotWarz replay";
+        return false;
+    }
+
+    size_t pos = sizeof(MAGIC);
+    m_initial.rows = static_cast<int>(getVar(pos));
+    m_initial.cols = static_cast<int>(getVar(pos));
+    m_keyframeInterval = static_cast<int>(getVar(pos));
+    m_initial.tiles.assign(static_cast<size_t>(m_initial.rows) * m_initial.cols, Tile::Empty);
+
+    size_t nTiles = getVar(pos);
+    size_t idx = 0;
+    for (size_t i = 0; i < nTiles && pos < m_data.size(); ++i) {
+        idx += getVar(pos);
+        Tile t = static_cast<Tile>(static_cast<uint8_t>(m_data[pos++]));
+        if (idx < m_initial.tiles.size()) m_initial.tiles[idx] = t;
+    }
+
+    size_t nRobots = getVar(pos);
+    m_initial.robots.assign(nRobots, ReplayRobot{});
+    for (auto& rb : m_initial.robots) {
+        size_t len = getVar(pos);
+        if (pos + len + 3 > m_data.size()) { m_error = "truncated spawn table"; return false; }
+        rb.name.assign(&m_data[pos], len);
+        pos += len;
+        rb.glyph   = m_data[pos++];
+        rb.idGlyph = m_data[pos++];
+        rb.weapon  = static_cast<uint8_t>(m_data[pos++]);
+        rb.move    = static_cast<int>(getVar(pos));
+    }
+    m_state = m_initial;
+    size_t bodyStart = pos;
+
+    // Prefer the trailer index; rebuild it by scanning if the game never finished.
+    m_index.clear();
+    bool indexed = false;
+    if (m_data.size() >= bodyStart + 12 &&
+        std::equal(TRAILER, TRAILER + 4, m_data.end() - 4)) {
+        uint64_t at = 0;
+        for (int i = 0; i < 8; ++i)
+            at |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[m_data.size() - 12 + i])) << (8 * i);
+        if (at < m_data.size() && static_cast<uint8_t>(m_data[at]) == BLK_INDEX) {
+            size_t p = at + 1;
+            m_lastRound = static_cast<int>(getVar(p));
+            m_stalemate = m_data[p++] != 0;
+            size_t n = getVar(p);
+            for (size_t i = 0; i < n && p + 8 <= m_data.size(); ++i) {
+                int round = static_cast<int>(getVar(p));
+                uint64_t off = 0;
+                for (int b = 0; b < 8; ++b)
+                    off |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[p++])) << (8 * b);
+                m_index.push_back({round, off});
+            }
+            m_bodyEnd = at;
+            indexed = !m_index.empty();
+        }
+    }
+    if (!indexed) {
+        m_bodyEnd = m_data.size();
+        pos = bodyStart;
+        while (pos < m_bodyEnd) {
+            size_t blockAt = pos;
+            uint8_t tag = static_cast<uint8_t>(m_data[pos++]);
+            if (tag == BLK_KEYFRAME) {
+                size_t p = pos;
+                m_index.push_back({static_cast<int>(getVar(p)), blockAt});
+                if (!readKeyframe(pos)) break;
+            } else if (tag == BLK_ROUND) {
+                size_t p = pos;
+                m_lastRound = static_cast<int>(getVar(p));
+                if (!readRound(pos, false)) break;
+            } else if (tag == BLK_END) {
+                m_lastRound = static_cast<int>(getVar(pos));
+                m_stalemate = pos < m_data.size() && m_data[pos] != 0;
+                break;
+            } else {
+                break;
+            }
+        }
+        if (m_index.empty()) { m_error = "replay has no keyframes"; return false; }
+    }
+
+    m_state = m_initial;
+    return seek(0);
+}
+
+bool ReplayReader::readKeyframe(size_t& pos) {
+    m_state.round = static_cast<int>(getVar(pos));
+    for (auto& rb : m_state.robots) {
+        rb.r        = static_cast<int>(getVar(pos));
+        rb.c        = static_cast<int>(getVar(pos));
+        rb.health   = static_cast<int>(getVar(pos));
+        rb.armor    = static_cast<int>(getVar(pos));
+        rb.grenades = static_cast<int>(getVar(pos));
+        if (pos >= m_data.size()) return false;
+        uint8_t f = static_cast<uint8_t>(m_data[pos++]);
+        rb.alive   = f & F_ALIVE;
+        rb.trapped = f & F_TRAPPED;
+    }
+    return true;
+}
+
+bool ReplayReader::readRound(size_t& pos, bool keepActions) {
+    m_state.round = static_cast<int>(getVar(pos));
+    if (keepActions) m_actions.clear();
+
+    size_t nActions = getVar(pos);
+    for (size_t i = 0; i < nActions; ++i) {
+        ReplayAction a;
+        a.robot = static_cast<int>(getVar(pos));
+        if (pos + 2 > m_data.size()) return false;
+        a.radarDir = static_cast<uint8_t>(m_data[pos++]);
+        a.kind = static_cast<ReplayActionKind>(static_cast<uint8_t>(m_data[pos++]));
+        if (a.kind != ReplayActionKind::None) {
+            a.a = static_cast<int>(getSigned(pos));
+            a.b = static_cast<int>(getSigned(pos));
+        }
+        if (keepActions) m_actions.push_back(a);
+    }
+
+    size_t nDeltas = getVar(pos);
+    for (size_t i = 0; i < nDeltas; ++i) {
+        size_t who = getVar(pos);
+        if (pos >= m_data.size() || who >= m_state.robots.size()) return false;
+        uint8_t mask = static_cast<uint8_t>(m_data[pos++]);
+        auto& rb = m_state.robots[who];
+        if (mask & D_POS)      { rb.r = static_cast<int>(getVar(pos)); rb.c = static_cast<int>(getVar(pos)); }
+        if (mask & D_HEALTH)   rb.health   = static_cast<int>(getVar(pos));
+        if (mask & D_ARMOR)    rb.armor    = static_cast<int>(getVar(pos));
+        if (mask & D_GRENADES) rb.grenades = static_cast<int>(getVar(pos));
+        if (mask & D_FLAGS) {
+            if (pos >= m_data.size()) return false;
+            uint8_t f = static_cast<uint8_t>(m_data[pos++]);
+            rb.alive   = f & F_ALIVE;
+            rb.trapped = f & F_TRAPPED;
+        }
+    }
+    return true;
+}
+
+bool ReplayReader::seek(int round) {
+    round = std::clamp(round, 0, m_lastRound);
+
+    // latest keyframe strictly before the target, so the target round's own
+    // actions are replayed (keyframe k is written after round k's block)
+    auto it = std::upper_bound(m_index.begin(), m_index.end(), std::max(0, round - 1),
+                               [](int r, const std::pair<int, uint64_t>& e) { return r < e.first; });
+    if (it != m_index.begin()) --it;
+
+    size_t pos = static_cast<size_t>(it->second);
+    m_actions.clear();
+    if (pos >= m_bodyEnd || static_cast<uint8_t>(m_data[pos++]) != BLK_KEYFRAME || !readKeyframe(pos)) {
+        m_error = "corrupt keyframe";
+        return false;
+    }
+
+    while (pos < m_bodyEnd && m_state.round < round) {
+        uint8_t tag = static_cast<uint8_t>(m_data[pos]);
+        if (tag == BLK_KEYFRAME) {
+            ++pos;
+            if (!readKeyframe(pos)) break;
+        } else if (tag == BLK_ROUND) {
+            size_t p = pos + 1;
+            int next = static_cast<int>(getVar(p));
+            if (next > round) break;
+            ++pos;
+            if (!readRound(pos, next == round)) { m_error = "corrupt round block"; return false; }
+        } else {
+            break;
+        }
+    }
+    m_state.round = round;
+    return true;
+}
+
+// ---------------------------------------------------------------- printing
+
+void ReplayState::printBoard(std::ostream& os) const {
+    std::vector<int> at(tiles.size(), -1);
+    for (size_t i = 0; i < robots.size(); ++i) {
+        const auto& rb = robots[i];
+        if (rb.r >= 0 && rb.r < rows && rb.c >= 0 && rb.c < cols)
+            at[static_cast<size_t>(rb.r) * cols + rb.c] = static_cast<int>(i);
+    }
+
+    os << "\n\n\n    ";
+    for (int c = 0; c < cols; ++c) os << std::setw(3) << c << " ";
+    os << '\n' << ' ';
+    for (int r = 0; r < rows; ++r) {
+        os << std::setw(2) << r << "  ";
+        for (int c = 0; c < cols; ++c) {
+            size_t cell = static_cast<size_t>(r) * cols + c;
+            if (at[cell] >= 0) {
+                const auto& rb = robots[at[cell]];
+                os << (rb.alive ? rb.glyph : 'X') << rb.idGlyph;
+            } else {
+                os << ' ' << tileGlyph(tiles[cell]);
+            }
+            os << ' ' << ' ';
+        }
+        os << '\n' << '\n' << ' ';
+    }
+}
@@ -0,0 +1,118 @@
+//Replay.h
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <span>
+#include <vector>
+#include "Board.h"
+#include "Tile.h"
+
+struct RobotEntry;
+
+// Replay files (.rwr) are event-sourced: header, initial terrain, spawns,
+// then one block per round holding each turn's radar/shot/move and the
+// resulting per-robot state deltas. A full keyframe is written every
+// keyframeInterval rounds and indexed in a trailer so a reader can jump
+// to any round by loading the latest keyframe before it and applying at
+// most keyframeInterval delta blocks. Integers are LEB128 varints.
+
+enum class ReplayActionKind : uint8_t { None = 0, Shot = 1, Move = 2 };
+
+struct ReplayAction {
+    int robot = 0;
+    int radarDir = 0;
+    ReplayActionKind kind = ReplayActionKind::None;
+    int a = 0, b = 0;    // shot row/col or move dir/dist
+};
+
+struct ReplayRobot {
+    std::string name;
+    char glyph = 'R';
+    char idGlyph = '?';
+    int weapon = 0;
+    int r = 0, c = 0;
+    int health = 0, armor = 0, move = 0, grenades = 0;
+    bool alive = true;
+    bool trapped = false;
+};
+
+struct ReplayState {
+    int rows = 0, cols = 0;
+    int round = 0;
+    std::vector<Tile> tiles;          // rows*cols, row-major
+    std::vector<ReplayRobot> robots;
+
+    void printBoard(std::ostream& os) const;
+};
+
+class ReplayWriter {
+public:
+    explicit ReplayWriter(const std::string& path, int keyframeInterval = 64);
+    ~ReplayWriter();
+    bool ok() const { return static_cast<bool>(m_out); }
+
+    template <class BoardT>
+    void begin(const BoardT& board, std::span<const RobotEntry> robots);
+    void action(int robot, int radarDir, ReplayActionKind kind, int a, int b);
+    void endRound(int round, std::span<const RobotEntry> robots);
+    void finish(int rounds, bool stalemate);
+
+private:
+    struct Cached { int r, c, health, armor, grenades; uint8_t flags; };
+    static Cached capture(const RobotEntry& re);
+
+    void putVar(uint64_t v);
+    void putSigned(int64_t v);
+    void putByte(uint8_t b) { m_buf.push_back(static_cast<char>(b)); }
+    void putFixed64(uint64_t v);
+    void flush(bool force = false);
+    uint64_t offset() const { return m_flushed + m_buf.size(); }
+    void writeKeyframe(int round);
+
+    std::ofstream m_out;
+    std::string m_buf;
+    uint64_t m_flushed = 0;
+    int m_keyframeInterval;
+    bool m_finished = false;
+    std::vector<Cached> m_state;
+    std::vector<ReplayAction> m_actions;
+    std::vector<std::pair<size_t, uint8_t>> m_changed;   // (robot, delta mask) this round
+    std::vector<std::pair<int, uint64_t>> m_index;       // (round, offset) of keyframes
+};
+
+class ReplayReader {
+public:
+    bool open(const std::string& path);
+    const std::string& error() const { return m_error; }
+
+    int rows() const { return m_initial.rows; }
+    int cols() const { return m_initial.cols; }
+    int lastRound() const { return m_lastRound; }
+    bool stalemate() const { return m_stalemate; }
+    int keyframeInterval() const { return m_keyframeInterval; }
+
+    // Reconstructs the world as it was after `round` finished (0 = spawns).
+    bool seek(int round);
+    const ReplayState& state() const { return m_state; }
+    // Turns played during the round last seeked to.
+    const std::vector<ReplayAction>& actions() const { return m_actions; }
+
+private:
+    uint64_t getVar(size_t& pos) const;
+    int64_t getSigned(size_t& pos) const;
+    bool readKeyframe(size_t& pos);
+    bool readRound(size_t& pos, bool keepActions);
+
+    std::vector<char> m_data;
+    std::string m_error;
+    ReplayState m_initial;
+    ReplayState m_state;
+    std::vector<ReplayAction> m_actions;
+    std::vector<std::pair<int, uint64_t>> m_index;
+    int m_keyframeInterval = 0;
+    int m_lastRound = 0;
+    bool m_stalemate = false;
+    size_t m_bodyEnd = 0;
+};
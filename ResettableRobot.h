@@ -0,0 +1,18 @@
+//ResettableRobot.h
+#pragma once
+
+// Opt-in hook for robots that can be reused from one game to the next (see
+// RobotPool). The arena looks for it with dynamic_cast, so robots without
+// it keep working; they are just deleted and rebuilt every game.
+class ResettableRobot {
+public:
+    // Put the robot back in the state a freshly constructed one is in,
+    // RobotBase health, armor and movement included. Called at the point the
+    // destructor would otherwise run, so any end-of-game work the destructor
+    // does belongs here too. Copy-assigning from a fresh instance covers
+    // both the base and the robot's own members and keeps vector capacity.
+    virtual void reset_for_new_game() = 0;
+
+protected:
+    ~ResettableRobot() = default;
+};
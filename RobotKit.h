@@ -0,0 +1,77 @@
+//RobotKit.h
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "RobotBase.h"
+
+// Helpers robots keep needing, header-only so a robot built on its own
+// (test_robot, a shared object) needs nothing else. Directions are the
+// arena's 1..8 numbering from `directions` in RobotBase.h, clockwise from
+// up; 0 means none.
+namespace RobotKit {
+
+    constexpr int sign(int v) { return (v > 0) - (v < 0); }
+    constexpr int absv(int v) { return v < 0 ? -v : v; }
+
+    // DIR_OF[sign(dr) + 1][sign(dc) + 1]: the direction a step points in.
+    inline constexpr std::array<std::array<int8_t, 3>, 3> DIR_OF = [] {
+        std::array<std::array<int8_t, 3>, 3> t{};
+        for (int d = 1; d <= 8; ++d)
+            t[directions[d].first + 1][directions[d].second + 1] = static_cast<int8_t>(d);
+        return t;
+    }();
+
+    // The direction from the origin towards (dr, dc), rounded to one of the
+    // eight by sign (so only exact for aligned offsets); 0 for (0, 0).
+    constexpr int dirOf(int dr, int dc) { return DIR_OF[sign(dr) + 1][sign(dc) + 1]; }
+
+    inline constexpr std::array<int8_t, 9> OPPOSITE = {0, 5, 6, 7, 8, 1, 2, 3, 4};
+    constexpr int opposite(int dir) { return OPPOSITE[dir]; }
+
+    // Same row, column or diagonal: where a railgun or radar ray can reach.
+    constexpr bool aligned(int dr, int dc) { return dr == 0 || dc == 0 || absv(dr) == absv(dc); }
+    // The direction of an aligned offset, or 0 when it is not aligned.
+    constexpr int alignedDir(int dr, int dc) { return aligned(dr, dc) ? dirOf(dr, dc) : 0; }
+
+    // Moves needed with diagonal steps allowed.
+    constexpr int chebyshev(int dr, int dc) {
+        int a = absv(dr), b = absv(dc);
+        return a > b ? a : b;
+    }
+    constexpr int manhattan(int dr, int dc) { return absv(dr) + absv(dc); }
+
+    static_assert(dirOf(-3, 3) == 2 && dirOf(0, -1) == 7 && dirOf(0, 0) == 0);
+    static_assert(opposite(1) == 5 && opposite(8) == 4 && alignedDir(2, 1) == 0);
+
+    // One bit per board cell for what a robot has learned about the board,
+    // instead of a list searched on every lookup. Sized from the robot's
+    // board bounds with fit(); out-of-bounds cells read as clear.
+    class ObstacleMap {
+    public:
+        // Resizes (and clears) only when the board size changes.
+        void fit(int rows, int cols) {
+            if (rows == m_rows && cols == m_cols) return;
+            m_rows = rows > 0 ? rows : 0;
+            m_cols = cols > 0 ? cols : 0;
+            m_bits.assign((static_cast<size_t>(m_rows) * m_cols + 63) / 64, 0);
+        }
+        void clear() { std::fill(m_bits.begin(), m_bits.end(), 0); }
+
+        bool test(int r, int c) const {
+            if (r < 0 || c < 0 || r >= m_rows || c >= m_cols) return false;
+            size_t i = static_cast<size_t>(r) * m_cols + c;
+            return m_bits[i >> 6] >> (i & 63) & 1u;
+        }
+        void set(int r, int c) {
+            if (r < 0 || c < 0 || r >= m_rows || c >= m_cols) return;
+            size_t i = static_cast<size_t>(r) * m_cols + c;
+            m_bits[i >> 6] |= uint64_t{1} << (i & 63);
+        }
+
+    private:
+        int m_rows = 0, m_cols = 0;
+        std::vector<uint64_t> m_bits;
+    };
+}
@@ -0,0 +1,34 @@
+//RobotPool.cpp
+#include "RobotPool.h"
+#include "ResettableRobot.h"
+
+RobotPool::~RobotPool() {
+    for (auto& [factory, bots] : m_free)
+        for (RobotBase* bot : bots) delete bot;
+}
+
+RobotBase* RobotPool::acquire(RobotFactory factory, RobotWrapper wrap) {
+    auto& free = m_free[{factory, wrap}];
+    if (!free.empty()) {
+        RobotBase* bot = free.back();
+        free.pop_back();
+        ++m_reused;
+        return bot;
+    }
+    RobotBase* bot = wrap ? wrap(factory) : factory();
+    m_origin[bot] = {factory, wrap};
+    ++m_created;
+    return bot;
+}
+
+void RobotPool::release(RobotBase* bot) {
+    auto it = m_origin.find(bot);
+    auto* resettable = dynamic_cast<ResettableRobot*>(bot);
+    if (it == m_origin.end() || !resettable) {
+        if (it != m_origin.end()) m_origin.erase(it);
+        delete bot;
+        return;
+    }
+    resettable->reset_for_new_game();
+    m_free[it->second].push_back(bot);
+}
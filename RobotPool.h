@@ -0,0 +1,40 @@
+//RobotPool.h
+#pragma once
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "RobotBase.h"
+
+// Builds something standing in for a robot from `factory`, such as
+// SandboxedRobot::create.
+typedef RobotBase* (*RobotWrapper)(RobotFactory factory);
+
+// Keeps robots alive between games so a long tournament does not build
+// and tear down every robot (and its heap-backed members) each game.
+// Only robots implementing ResettableRobot are kept; anything else is
+// deleted on release and rebuilt by its factory on the next acquire.
+class RobotPool {
+public:
+    RobotPool() = default;
+    ~RobotPool();
+    RobotPool(const RobotPool&) = delete;
+    RobotPool& operator=(const RobotPool&) = delete;
+
+    // A robot from `factory`, reused if one is free. With a wrapper, the
+    // robot is `wrap(factory)` instead, pooled apart from unwrapped ones.
+    RobotBase* acquire(RobotFactory factory, RobotWrapper wrap = nullptr);
+    // Takes the robot back at game end: resets it for reuse, or deletes it.
+    void release(RobotBase* bot);
+
+    size_t created() const { return m_created; }
+    size_t reused()  const { return m_reused; }
+
+private:
+    using Origin = std::pair<RobotFactory, RobotWrapper>;
+    std::map<Origin, std::vector<RobotBase*>> m_free;
+    std::unordered_map<const RobotBase*, Origin> m_origin;
+    size_t m_created = 0;
+    size_t m_reused = 0;
+};
@@ -1,10 +1,12 @@
 #include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "RobotKit.h"
 #include <vector>
 #include <utility>
 #include <cmath>
 #include <limits>
 
-class Robot_CornerSniper : public RobotBase {
+class Robot_CornerSniper : public RobotBase, public ResettableRobot {
 private:
     // last radar results (only enemies)
     std::vector<std::pair<int,int>> last_seen_this_turn;
@@ -16,19 +18,6 @@ private:
     int  corner_r     = 0;
     int  corner_c     = 0;
 
-    // Map direction vector to dir code (1..8), same convention as Arena/Reaper.
-    int dirFromVec(int sgnr, int sgnc) const {
-        if      (sgnr == -1 && sgnc ==  0) return 1;
-        else if (sgnr == -1 && sgnc ==  1) return 2;
-        else if (sgnr ==  0 && sgnc ==  1) return 3;
-        else if (sgnr ==  1 && sgnc ==  1) return 4;
-        else if (sgnr ==  1 && sgnc ==  0) return 5;
-        else if (sgnr ==  1 && sgnc == -1) return 6;
-        else if (sgnr ==  0 && sgnc == -1) return 7;
-        else if (sgnr == -1 && sgnc == -1) return 8;
-        return 0;
-    }
-
     void chooseCornerIfNeeded() {
         if (cornerChosen) return;
         if (m_board_row_max <= 0 || m_board_col_max <= 0) return;
@@ -75,6 +64,11 @@ public:
         // Simple, fragile railgun camper.
     }
 
+    void reset_for_new_game() override {
+        const Robot_CornerSniper fresh;
+        *this = fresh;
+    }
+
     ~Robot_CornerSniper() override = default;
 
     void get_radar_direction(int& radar_direction) override {
@@ -125,11 +119,8 @@ public:
             int dr = rr - cr;
             int dc = cc2 - cc;
 
-            bool aligned = (dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc));
-            if (aligned && !have_lock) {
-                int sgnr = (dr > 0) - (dr < 0);
-                int sgnc = (dc > 0) - (dc < 0);
-                locked_dir = dirFromVec(sgnr, sgnc);
+            if (RobotKit::aligned(dr, dc) && !have_lock) {
+                locked_dir = RobotKit::dirOf(dr, dc);
                 have_lock  = true;
             }
         }
@@ -147,18 +138,11 @@ public:
         int cr, cc;
         get_current_location(cr, cc);
 
-        static const std::pair<int,int> dirs[9] = {
-            {0,0},{-1,0},{-1,1},{0,1},{1,1},{1,0},{1,-1},{0,-1},{-1,-1}
-        };
-
         auto alignedWith = [&](int r, int c, int dir) -> bool {
             int dr = r - cr;
             int dc = c - cc;
-            if (!((dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc)))) return false;
-            if (dir == 0) return true;
-            int sgnr = (dr > 0) - (dr < 0);
-            int sgnc = (dc > 0) - (dc < 0);
-            return dirs[dir].first == sgnr && dirs[dir].second == sgnc;
+            if (!RobotKit::aligned(dr, dc)) return false;
+            return dir == 0 || RobotKit::dirOf(dr, dc) == dir;
         };
 
         // 1) Prefer targets aligned with locked_dir if we have it.
@@ -168,7 +152,7 @@ public:
         if (locked_dir != 0) {
             for (auto [r, c] : last_seen_this_turn) {
                 if (!alignedWith(r, c, locked_dir)) continue;
-                int d = std::max(std::abs(r - cr), std::abs(c - cc));
+                int d = RobotKit::chebyshev(r - cr, c - cc);
                 if (d < bestd) {
                     bestd = d;
                     best  = {r, c};
@@ -180,7 +164,7 @@ public:
         if (bestd == std::numeric_limits<int>::max()) {
             for (auto [r, c] : last_seen_this_turn) {
                 if (!alignedWith(r, c, 0)) continue;
-                int d = std::max(std::abs(r - cr), std::abs(c - cc));
+                int d = RobotKit::chebyshev(r - cr, c - cc);
                 if (d < bestd) {
                     bestd = d;
                     best  = {r, c};
@@ -209,11 +193,9 @@ public:
         if (cornerChosen) {
             int dr = corner_r - cr;
             int dc = corner_c - cc;
-            int cheb = std::max(std::abs(dr), std::abs(dc));
+            int cheb = RobotKit::chebyshev(dr, dc);
             if (cheb > 0) {
-                int sgnr = (dr > 0) - (dr < 0);
-                int sgnc = (dc > 0) - (dc < 0);
-                int d = dirFromVec(sgnr, sgnc);
+                int d = RobotKit::dirOf(dr, dc);
                 if (d != 0) {
                     direction = d;
                     distance  = std::min(get_move_speed(), cheb);
@@ -228,7 +210,7 @@ public:
         int er = cr, ec = cc;
 
         for (auto [r, c] : last_seen_this_turn) {
-            int ch = std::max(std::abs(r - cr), std::abs(c - cc));
+            int ch = RobotKit::chebyshev(r - cr, c - cc);
             if (ch < bestCheb) {
                 bestCheb = ch;
                 er = r;
@@ -238,11 +220,7 @@ public:
 
         if (bestCheb <= 2) {
             // Enemy too close: step one tile away from them.
-            int dr = cr - er;
-            int dc = cc - ec;
-            int sgnr = (dr > 0) - (dr < 0);
-            int sgnc = (dc > 0) - (dc < 0);
-            int d = dirFromVec(sgnr, sgnc);
+            int d = RobotKit::dirOf(cr - er, cc - ec);
             if (d != 0) {
                 direction = d;
                 distance  = 1;
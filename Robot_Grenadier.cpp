@@ -1,51 +1,38 @@
 #include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "SpanRadarRobot.h"
+#include "RobotKit.h"
 #include <vector>
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
 #include <limits>
 
-class Robot_Grenadier : public RobotBase {
+class Robot_Grenadier : public RobotBase, public ResettableRobot, public SpanRadarRobot {
 private:
     bool  m_hasTarget = false;
     int   m_targetRow = -1;
     int   m_targetCol = -1;
     int   m_radarDir  = 1;   // 1–8, cycles when no target
 
-    // Manhattan distance
-    int manhattan(int r1, int c1, int r2, int c2) const {
-        return std::abs(r1 - r2) + std::abs(c1 - c2);
-    }
-
-    int to_dir(int dr, int dc) const {
-        // Normalize to sign
-        int sgnr = (dr > 0) - (dr < 0);
-        int sgnc = (dc > 0) - (dc < 0);
-
-        if (sgnr == -1 && sgnc ==  0) return 1; // up
-        if (sgnr == -1 && sgnc ==  1) return 2; // up-right
-        if (sgnr ==  0 && sgnc ==  1) return 3; // right
-        if (sgnr ==  1 && sgnc ==  1) return 4; // down-right
-        if (sgnr ==  1 && sgnc ==  0) return 5; // down
-        if (sgnr ==  1 && sgnc == -1) return 6; // down-left
-        if (sgnr ==  0 && sgnc == -1) return 7; // left
-        if (sgnr == -1 && sgnc == -1) return 8; // up-left
-        return 0;
-    }
-
 public:
     Robot_Grenadier() : RobotBase(3, 4, grenade) {
         std::srand(static_cast<unsigned int>(std::time(nullptr)));
         m_name = "Grenadier";
     }
 
+    void reset_for_new_game() override {
+        const Robot_Grenadier fresh;
+        *this = fresh;
+    }
+
     void get_radar_direction(int& radar_direction) override {
         if (m_hasTarget) {
             int cr, cc;
             get_current_location(cr, cc);
             int dr = m_targetRow - cr;
             int dc = m_targetCol - cc;
-            int dir = to_dir(dr, dc);
+            int dir = RobotKit::dirOf(dr, dc);
             if (dir != 0) {
                 radar_direction = dir;
                 return;
@@ -56,7 +43,16 @@ public:
     }
 
     void process_radar_results(const std::vector<RadarObj>& radar_results) override {
+        int cr, cc;
+        get_current_location(cr, cc);
+        process_radar_span(radar_results, summarizeRadar(radar_results, cr, cc));
+    }
+
+    void process_radar_span(std::span<const RadarObj> radar_results, const RadarSummary& summary) override {
         m_hasTarget = false;
+        m_targetRow = m_targetCol = -1;
+        if (!summary.anyEnemy()) return;
+
         int cr, cc;
         get_current_location(cr, cc);
 
@@ -65,7 +61,7 @@ public:
         for (const auto& obj : radar_results) {
             // Treat 'R' as enemy robot in the arena printout
             if (obj.m_type == 'R') {
-                int d = manhattan(cr, cc, obj.m_row, obj.m_col);
+                int d = RobotKit::manhattan(obj.m_row - cr, obj.m_col - cc);
                 if (d < bestDist) {
                     bestDist  = d;
                     m_targetRow = obj.m_row;
@@ -74,10 +70,6 @@ public:
                 }
             }
         }
-
-        if (!m_hasTarget) {
-            m_targetRow = m_targetCol = -1;
-        }
     }
 
     bool get_shot_location(int& shot_row, int& shot_col) override {
@@ -86,7 +78,7 @@ public:
 
         int cr, cc;
         get_current_location(cr, cc);
-        int d = manhattan(cr, cc, m_targetRow, m_targetCol);
+        int d = RobotKit::manhattan(m_targetRow - cr, m_targetCol - cc);
 
         // Prefer mid-range throws; if too close, don't waste grenades
         if (d >= 2 && d <= 7) {
@@ -107,14 +99,14 @@ public:
         move_distance  = 0;
 
         if (m_hasTarget) {
-            int d = manhattan(cr, cc, m_targetRow, m_targetCol);
+            int d = RobotKit::manhattan(m_targetRow - cr, m_targetCol - cc);
 
             // If very close, try backing away to avoid hammer/flame range
             if (d <= 2) {
                 int dr = cr - m_targetRow;
                 int dc = cc - m_targetCol;
 
-                int dir = to_dir(dr, dc);
+                int dir = RobotKit::dirOf(dr, dc);
                 if (dir != 0) {
                     move_direction = dir;
                     move_distance  = 1;
@@ -126,7 +118,7 @@ public:
             if (d > 5) {
                 int dr = m_targetRow - cr;
                 int dc = m_targetCol - cc;
-                int dir = to_dir(dr, dc);
+                int dir = RobotKit::dirOf(dr, dc);
                 if (dir != 0) {
                     move_direction = dir;
                     move_distance  = 1;
@@ -144,7 +136,7 @@ public:
                 int dr = m_targetRow - cr;
                 int dc = m_targetCol - cc;
                 // rotate vector 90 degrees
-                int sdir = to_dir(-dc, dr);
+                int sdir = RobotKit::dirOf(-dc, dr);
                 if (sdir != 0) {
                     move_direction = sdir;
                     move_distance  = 1;
@@ -153,7 +145,7 @@ public:
                 // strafe right
                 int dr = m_targetRow - cr;
                 int dc = m_targetCol - cc;
-                int sdir = to_dir(dc, -dr);
+                int sdir = RobotKit::dirOf(dc, -dr);
                 if (sdir != 0) {
                     move_direction = sdir;
                     move_distance  = 1;
@@ -1,12 +1,14 @@
 #include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "SpanRadarRobot.h"
+#include "RobotKit.h"
 #include <cstdlib>
 #include <ctime>
-#include <set>
 #include <cmath>
 #include <limits>
 #include <utility>
 
-class Robot_Hammer : public RobotBase 
+class Robot_Hammer : public RobotBase, public ResettableRobot, public SpanRadarRobot 
 {
 private:
     bool target_found = false;
@@ -15,17 +17,17 @@ private:
 
     int radar_direction = 1; // Radar scanning direction (1-8)
     bool fixed_radar = false; // Tracks whether radar is locked on a target
-    const int max_range = 1; // Maximum range of the flamethrower
-    std::set<std::pair<int, int>> obstacles_memory; // Memory of obstacles
+    static constexpr int max_range = 1; // Maximum range of the flamethrower
+    RobotKit::ObstacleMap obstacles_memory; // Memory of obstacles
 
     // Helper function to calculate Manhattan distance
     int calculate_distance(int row1, int col1, int row2, int col2) const 
     {
-        return std::abs(row1 - row2) + std::abs(col1 - col2);
+        return RobotKit::manhattan(row1 - row2, col1 - col2);
     }
 
     // Find the closest enemy from the radar results
-    void find_closest_enemy(const std::vector<RadarObj>& radar_results, int current_row, int current_col) 
+    void find_closest_enemy(std::span<const RadarObj> radar_results, int current_row, int current_col) 
     {
         target_found = false;
         int closest_distance = std::numeric_limits<int>::max();
@@ -48,13 +50,14 @@ private:
     }
 
     // Update the memory of obstacles
-    void update_obstacle_memory(const std::vector<RadarObj>& radar_results) 
+    void update_obstacle_memory(std::span<const RadarObj> radar_results) 
     {
+        obstacles_memory.fit(m_board_row_max, m_board_col_max);
         for (const auto& obj : radar_results) 
         {
             if (obj.m_type == 'M' || obj.m_type == 'P' || obj.m_type == 'F') 
             {
-                obstacles_memory.insert({obj.m_row, obj.m_col});
+                obstacles_memory.set(obj.m_row, obj.m_col);
             }
         }
     }
@@ -62,7 +65,7 @@ private:
     // Check if a cell is passable
     bool is_passable(int row, int col) const 
     {
-        return obstacles_memory.find({row, col}) == obstacles_memory.end();
+        return !obstacles_memory.test(row, col);
     }
 
 public:
@@ -71,6 +74,11 @@ public:
         std::srand(static_cast<unsigned int>(std::time(nullptr))); // Seed for random movement
     }
 
+    void reset_for_new_game() override {
+        const Robot_Hammer fresh;
+        *this = fresh;
+    }
+
     // Set the radar direction for scanning
     virtual void get_radar_direction(int& radar_direction_out) override 
     {
@@ -90,15 +98,25 @@ public:
     // Process the radar results and update the target and obstacles
     virtual void process_radar_results(const std::vector<RadarObj>& radar_results) override 
     {
-        target_found = false; // Reset target state
         int current_row, current_col;
         get_current_location(current_row, current_col);
+        process_radar_span(radar_results, summarizeRadar(radar_results, current_row, current_col));
+    }
+
+    void process_radar_span(std::span<const RadarObj> radar_results, const RadarSummary& summary) override 
+    {
+        target_found = false; // Reset target state
 
         // Update obstacle memory
         update_obstacle_memory(radar_results);
 
         // Look for the closest enemy in the radar results
-        find_closest_enemy(radar_results, current_row, current_col);
+        if (summary.anyEnemy()) 
+        {
+            int current_row, current_col;
+            get_current_location(current_row, current_col);
+            find_closest_enemy(radar_results, current_row, current_col);
+        }
 
         if (!target_found) 
         {
@@ -0,0 +1,209 @@
+#include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "SpanRadarRobot.h"
+#include "AnytimeRobot.h"
+#include "RobotKit.h"
+#include <vector>
+#include <limits>
+
+// Railgun that plans where to stand: a breadth-first search over the cells
+// it has not seen blocked, scored by how many recently seen enemies each
+// one lines up with. The search can take longer than a turn on a big
+// board, so it runs as an anytime think(): every turn gets the shot or the
+// step toward the best cell found so far, and the search carries on into
+// the next turn (or between turns, with a thread pool).
+class Robot_Planner : public RobotBase, public ResettableRobot, public SpanRadarRobot, public AnytimeRobot {
+private:
+    struct Sighting { int row, col, turn; };
+    static constexpr int MEMORY = 12;       // turns a sighting stays worth lining up with
+    static constexpr int MAX_SIGHTINGS = 32;
+
+    // Copied from the base in process_radar_span, since think() may run in
+    // the background where RobotBase is off limits.
+    int m_turn = 0;
+    int m_row = 0, m_col = 0, m_speed = 0, m_rows = 0, m_cols = 0;
+
+    RobotKit::ObstacleMap m_blocked;        // mounds, pits, flames and corpses seen so far
+    std::vector<Sighting> m_seen;
+    bool m_hasTarget = false;
+    int  m_targetRow = -1;
+    int  m_targetCol = -1;
+    int  m_radarDir  = 1; // sweep 1-8
+
+    int m_goalRow = -1, m_goalCol = -1;     // best cell of the last finished plan; -1: none yet
+    std::vector<int> m_dist;                // search scratch, reused by every plan
+    std::vector<int> m_frontier;
+
+    // The step toward (row, col) this turn: straight at it, or either
+    // neighbouring direction when the first cell that way is known blocked.
+    AnytimeAction stepToward(int row, int col) const {
+        int dr = row - m_row, dc = col - m_col;
+        int dir = RobotKit::dirOf(dr, dc);
+        if (dir == 0) return {};
+        int limit = m_speed;
+        if (dr == 0 || dc == 0) limit = std::min(limit, RobotKit::chebyshev(dr, dc));
+        else limit = std::min({limit, RobotKit::absv(dr), RobotKit::absv(dc)});
+
+        for (int turn : {0, 1, 7}) {
+            int d = (dir - 1 + turn) % 8 + 1;
+            int dist = 0;
+            while (dist < limit) {
+                int r = m_row + directions[d].first * (dist + 1);
+                int c = m_col + directions[d].second * (dist + 1);
+                if (r < 0 || c < 0 || r >= m_rows || c >= m_cols || m_blocked.test(r, c)) break;
+                ++dist;
+            }
+            if (dist > 0) return AnytimeAction::move(d, dist);
+        }
+        return {};
+    }
+
+    // What to do with a turn if thinking stops right now.
+    AnytimeAction quickAnswer() const {
+        if (m_hasTarget) return AnytimeAction::shot(m_targetRow, m_targetCol);
+        if (m_goalRow >= 0) return stepToward(m_goalRow, m_goalCol);
+        if (!m_seen.empty()) return stepToward(m_seen.back().row, m_seen.back().col);
+        return stepToward((m_rows - 1) / 2, (m_cols - 1) / 2);
+    }
+
+    int scoreCell(int r, int c, int dist) const {
+        int score = -4 * dist;
+        for (const Sighting& s : m_seen) {
+            int dr = s.row - r, dc = s.col - c;
+            int gap = RobotKit::chebyshev(dr, dc);
+            if (gap == 0) continue;
+            if (gap <= 1) score -= 50;      // close enough for flamers and hammers
+            else if (RobotKit::aligned(dr, dc)) score += 100 - 6 * (m_turn - s.turn);
+        }
+        return score;
+    }
+
+public:
+    Robot_Planner() : RobotBase(3, 4, railgun) {
+        m_name = "Planner";
+    }
+
+    void reset_for_new_game() override {
+        const Robot_Planner fresh;
+        *this = fresh;
+    }
+
+    void get_radar_direction(int& radar_direction) override {
+        if (!m_seen.empty()) {
+            int cr, cc;
+            get_current_location(cr, cc);
+            int dir = RobotKit::alignedDir(m_seen.back().row - cr, m_seen.back().col - cc);
+            if (dir != 0) {
+                radar_direction = dir;
+                return;
+            }
+        }
+        radar_direction = m_radarDir;
+        m_radarDir = (m_radarDir % 8) + 1;
+    }
+
+    void process_radar_results(const std::vector<RadarObj>& radar_results) override {
+        int cr, cc;
+        get_current_location(cr, cc);
+        process_radar_span(radar_results, summarizeRadar(radar_results, cr, cc));
+    }
+
+    void process_radar_span(std::span<const RadarObj> radar_results, const RadarSummary& summary) override {
+        ++m_turn;
+        get_current_location(m_row, m_col);
+        m_speed = get_move_speed();
+        m_rows = m_board_row_max;
+        m_cols = m_board_col_max;
+        m_blocked.fit(m_rows, m_cols);
+
+        std::erase_if(m_seen, [this](const Sighting& s) { return m_turn - s.turn > MEMORY; });
+        for (const auto& obj : radar_results) {
+            if (obj.m_type == '.') continue;
+            if (!radarIsEnemy(obj.m_type)) {
+                m_blocked.set(obj.m_row, obj.m_col);
+                continue;
+            }
+            std::erase_if(m_seen, [&](const Sighting& s) { return s.row == obj.m_row && s.col == obj.m_col; });
+            if (m_seen.size() == MAX_SIGHTINGS) m_seen.erase(m_seen.begin());
+            m_seen.push_back({ obj.m_row, obj.m_col, m_turn });
+        }
+
+        // every hit is on the scanned ray, so the nearest enemy is in line
+        m_hasTarget = summary.anyEnemy();
+        if (m_hasTarget) {
+            m_targetRow = radar_results[summary.nearestEnemy].m_row;
+            m_targetCol = radar_results[summary.nearestEnemy].m_col;
+        }
+    }
+
+    ThinkTask think(AnytimeTurns& turns) override {
+        for (;;) {
+            turns.commit(quickAnswer());
+            if (m_hasTarget) {
+                co_await turns.next();
+                continue;
+            }
+
+            int planned = turns.turn();
+            const int size = m_rows * m_cols;
+            m_dist.assign(size, -1);
+            m_frontier.clear();
+            m_frontier.push_back(m_row * m_cols + m_col);
+            m_dist[m_frontier[0]] = 0;
+
+            int bestScore = std::numeric_limits<int>::min();
+            int best = -1;
+            for (size_t head = 0; head < m_frontier.size(); ++head) {
+                if ((head & 63) == 63) {
+                    co_await turns.checkpoint();
+                    if (turns.turn() != planned) {
+                        // a new turn started mid-plan: answer it, then go on
+                        planned = turns.turn();
+                        turns.commit(quickAnswer());
+                    }
+                }
+                const int cell = m_frontier[head];
+                const int r = cell / m_cols, c = cell % m_cols;
+                if (!m_seen.empty()) {
+                    int score = scoreCell(r, c, m_dist[cell]);
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = cell;
+                    }
+                }
+                for (int d = 1; d <= 8; ++d) {
+                    int nr = r + directions[d].first, nc = c + directions[d].second;
+                    if (nr < 0 || nc < 0 || nr >= m_rows || nc >= m_cols) continue;
+                    int next = nr * m_cols + nc;
+                    if (m_dist[next] >= 0 || m_blocked.test(nr, nc)) continue;
+                    m_dist[next] = m_dist[cell] + 1;
+                    m_frontier.push_back(next);
+                }
+            }
+
+            m_goalRow = best < 0 ? -1 : best / m_cols;
+            m_goalCol = best < 0 ? -1 : best % m_cols;
+            turns.commit(quickAnswer());    // dropped if the plan finished between turns
+            co_await turns.next();
+        }
+    }
+
+    // Without the anytime model (test_robot, a sandbox) the robot plays
+    // its quick answer to the last plan.
+    bool get_shot_location(int& shot_row, int& shot_col) override {
+        if (!m_hasTarget) return false;
+        shot_row = m_targetRow;
+        shot_col = m_targetCol;
+        return true;
+    }
+
+    void get_move_direction(int& move_direction, int& move_distance) override {
+        AnytimeAction a = quickAnswer();
+        move_direction = a.kind == AnytimeAction::Move ? a.a : 0;
+        move_distance  = a.kind == AnytimeAction::Move ? a.b : 0;
+    }
+};
+
+extern "C" RobotBase* create_robot_planner() {
+    return new Robot_Planner();
+}
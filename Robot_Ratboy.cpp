@@ -1,20 +1,19 @@
 #include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "RobotKit.h"
 #include <vector>
 #include <iostream>
-#include <algorithm> // For std::find_if
+#include <algorithm>
 
-class Robot_Ratboy:public RobotBase{
+class Robot_Ratboy : public RobotBase, public ResettableRobot{
 private:
     bool m_moving_down=true;// Tracks vertical movement direction
     int to_shoot_row=-1;// Tracks the row of the next target to shoot
     int to_shoot_col=-1;// Tracks the column of the next target to shoot
-    std::vector<RadarObj> known_obstacles; // Permanent obstacle list
+    RobotKit::ObstacleMap known_obstacles; // Permanent obstacle map
     // Helper function to determine if a cell is an obstacle
     bool is_obstacle(int row, int col) const{
-        return std::any_of(known_obstacles.begin(), known_obstacles.end(), 
-                           [&](const RadarObj& obj) {
-                               return obj.m_row == row && obj.m_col == col;
-                           });}
+        return known_obstacles.test(row, col);}
     // Clears the target when no enemy is found
     void clear_target(){
         to_shoot_row = -1;
@@ -22,12 +21,19 @@ private:
     // Helper function to add an obstacle to the list if it's not already there
     void add_obstacle(const RadarObj& obj){
     const bool is_static = (obj.m_type=='M' || obj.m_type=='P' || obj.m_type=='F');
-    if (is_static && !is_obstacle(obj.m_row, obj.m_col)) {
-        known_obstacles.push_back(obj);
+    if (is_static) {
+        known_obstacles.fit(m_board_row_max, m_board_col_max);
+        known_obstacles.set(obj.m_row, obj.m_col);
     }
 }
 public:
     Robot_Ratboy() : RobotBase(3, 4, railgun) {} // Initialize with 3 movement, 4 armor, railgun
+
+    void reset_for_new_game() override {
+        const Robot_Ratboy fresh;
+        *this = fresh;
+    }
+
     // Radar location for scanning in one of the 8 directions
     virtual void get_radar_direction(int& radar_direction) override{
         int current_row, current_col;
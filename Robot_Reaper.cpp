@@ -1,5 +1,7 @@
 //Robot_Reaper.cpp
 #include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "RobotKit.h"
 #include <vector>
 #include <cmath>
 #include <limits>
@@ -54,7 +56,7 @@ namespace {
 }
 
 
-class Robot_Reaper : public RobotBase {
+class Robot_Reaper : public RobotBase, public ResettableRobot {
 
 private:
     static constexpr int WEIGHT_COUNT = 20;
@@ -427,25 +429,19 @@ private:
         return false;
     }
 
-    int dirFromVec(int sgnr,int sgnc){
-        if      (sgnr==-1 && sgnc==0) return 1;
-        else if (sgnr==-1 && sgnc==1) return 2;
-        else if (sgnr==0  && sgnc==1) return 3;
-        else if (sgnr==1  && sgnc==1) return 4;
-        else if (sgnr==1  && sgnc==0) return 5;
-        else if (sgnr==1  && sgnc==-1)return 6;
-        else if (sgnr==0  && sgnc==-1)return 7;
-        else if (sgnr==-1 && sgnc==-1)return 8;
-        return 0;
-    }
-
     void ensureMemory() {
         if (memoryInitialized) return;
         if (m_board_row_max <= 0 || m_board_col_max <= 0) return;
 
-        terrainMemory.assign(m_board_row_max,std::vector<char>(m_board_col_max, '?'));
-        enemyEverSeen.assign(m_board_row_max, std::vector<bool>(m_board_col_max, false));
-        flameLastSeenTurn.assign(m_board_row_max,std::vector<int>(m_board_col_max, -1));
+        // refilled row by row, so a pooled Reaper's rows (kept across
+        // games by reset_for_new_game) are reused when the board size holds
+        auto refill = [this](auto& grid, auto value) {
+            grid.resize(m_board_row_max);
+            for (auto& row : grid) row.assign(m_board_col_max, value);
+        };
+        refill(terrainMemory, '?');
+        refill(enemyEverSeen, false);
+        refill(flameLastSeenTurn, -1);
         memoryInitialized = true;
     }
 
@@ -567,7 +563,7 @@ private:
         for (auto [er, ec] : last_seen_this_turn) {
             int dr = er - r;
             int dc = ec - c;
-            bool aligned = (dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc));
+            bool aligned = RobotKit::aligned(dr, dc);
             if (aligned) {
                 s += int(5000 * s_weights[W_DANGERLINE]);
                 break;
@@ -577,7 +573,7 @@ private:
         if (!last_seen_this_turn.empty()) {
             int minLive = 1000;
             for (auto [er, ec] : last_seen_this_turn) {
-                int dd = std::max(std::abs(er - r), std::abs(ec - c));
+                int dd = RobotKit::chebyshev(er - r, ec - c);
                 if (dd < minLive) minLive = dd;
             }
             if (minLive <= 2)      s += int(120'000 * s_weights[W_LIVE_CHEB2]);
@@ -588,10 +584,6 @@ private:
     }
 
     int scorePathRisk(int cr, int cc, int dir, int dist) {
-        static const std::pair<int,int> dirs[9] = {
-            {0,0},{-1,0},{-1,1},{0,1},{1,1},{1,0},{1,-1},{0,-1},{-1,-1}
-        };
-
         if (dir == 0 || dist <= 0) {
             return scorePositionWithLive(cr, cc);
         }
@@ -601,8 +593,8 @@ private:
         int worstStep = 0;
 
         for (int step = 1; step <= dist; ++step) {
-            r += dirs[dir].first;
-            c += dirs[dir].second;
+            r += directions[dir].first;
+            c += directions[dir].second;
 
             if (!inBounds(r, c)) {
                 return 1'000'000;
@@ -622,12 +614,8 @@ private:
     }
 
     int scoreEscapeDir(int cr, int cc, int d) {
-        static const std::pair<int,int> dirs[9] = {
-            {0,0},{-1,0},{-1,1},{0,1},{1,1},{1,0},{1,-1},{0,-1},{-1,-1}
-        };
-
-        int nr = cr + dirs[d].first;
-        int nc = cc + dirs[d].second;
+        int nr = cr + directions[d].first;
+        int nc = cc + directions[d].second;
         int s  = scoreTile(nr, nc);
         if (d != 0) {
             s += int(dangerLine[d] * 2500 * s_weights[W_DANGERLINE]);
@@ -636,7 +624,7 @@ private:
         if (!last_seen_this_turn.empty()) {
             int minLive = 1000;
             for (auto [er, ec] : last_seen_this_turn) {
-                int dd = std::max(std::abs(er - nr), std::abs(ec - nc));
+                int dd = RobotKit::chebyshev(er - nr, ec - nc);
                 if (dd < minLive) minLive = dd;
             }
             if (minLive <= 2)      s += int(100'000 * s_weights[W_LIVE_CHEB2]);
@@ -682,7 +670,7 @@ private:
             for (int rr = 0; rr < m_board_row_max; ++rr) {
                 for (int cc = 0; cc < m_board_col_max; ++cc) {
                     if (!enemyEverSeen[rr][cc]) continue;
-                    if (rr == r || cc == c || std::abs(rr - r) == std::abs(cc - c)) {
+                    if (RobotKit::aligned(rr - r, cc - c)) {
                         ++coverage;
                     }
                 }
@@ -741,10 +729,6 @@ private:
                                                         int huntTargetCol,
                                                         bool exploreMode)
                                 {
-                                    static const std::pair<int,int> dirs[9] = {
-                                        {0,0},{-1,0},{-1,1},{0,1},{1,1},{1,0},{1,-1},{0,-1},{-1,-1}
-                                    };
-
                                     int maxStep = getMaxStepForKnowledge();
 
                                     int bestScore = 1'000'000;
@@ -758,8 +742,8 @@ private:
 
                                     for (int d = 1; d <= 8; ++d) {
                                         for (int k = 1; k <= maxStep; ++k) {
-                                            int fr = cr + dirs[d].first * k;
-                                            int fc = cc + dirs[d].second * k;
+                                            int fr = cr + directions[d].first * k;
+                                            int fc = cc + directions[d].second * k;
 
                                             if (!inBounds(fr, fc)) break;
 
@@ -917,11 +901,32 @@ private:
                                     << "\n";
                                 }
 
+    // Set on the first radar call of a game. An instance that never
+    // played (the copy a reset starts from, a pooled robot left over at
+    // the end) has nothing to log or learn from.
+    bool m_played = false;
+
 public:
     Robot_Reaper(): RobotBase(2,5,railgun) {
         initWeightsIfNeeded();
     }
 
+    // Pooled reuse: do the game-end learning the destructor would have
+    // done, then start over as a fresh Reaper.
+    void reset_for_new_game() override {
+        if (m_played) learnFromGame();
+        // the per-board grids sit out the copy, which would free their
+        // rows; ensureMemory refills them in place next game
+        auto terrain = std::move(terrainMemory);
+        auto seen = std::move(enemyEverSeen);
+        auto flames = std::move(flameLastSeenTurn);
+        const Robot_Reaper fresh;
+        *this = fresh;
+        terrainMemory = std::move(terrain);
+        enemyEverSeen = std::move(seen);
+        flameLastSeenTurn = std::move(flames);
+    }
+
     int last_r=-1;
     int last_c=-1;
     int last_move_dir=0;
@@ -934,6 +939,10 @@ public:
 
 
     ~Robot_Reaper() override {
+        if (m_played) learnFromGame();
+    }
+
+    void learnFromGame() {
         logGameSummary();
 
         ReaperStatsRow st;
@@ -1019,6 +1028,7 @@ public:
 
 
     void process_radar_results(const std::vector<RadarObj>& radar_results) override {
+        m_played = true;
         ensureMemory();
         last_seen_this_turn.clear();
 
@@ -1075,15 +1085,13 @@ public:
             int dr = rr - cr;
             int dc = cc2 - cc;
 
-            if ((dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc))) {
-                int sgnr = (dr > 0) - (dr < 0);
-                int sgnc = (dc > 0) - (dc < 0);
-                int d = dirFromVec(sgnr, sgnc);
+            if (RobotKit::aligned(dr, dc)) {
+                int d = RobotKit::dirOf(dr, dc);
                 if (d != 0) {
                     dangerLine[d] += 1;
 
                     if (isRailgunBot(ot)) {
-                        int cheb = std::max(std::abs(dr), std::abs(dc));
+                        int cheb = RobotKit::chebyshev(dr, dc);
                         if (cheb <= 6) {
                             liveThreatDir[d] = 1;
                         }
@@ -1094,11 +1102,8 @@ public:
             last_seen_this_turn.push_back({rr, cc2});
             enemyEverSeen[rr][cc2] = true;
 
-            bool aligned = (dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc));
-            if (aligned && !have_lock) {
-                int sgnr = (dr > 0) - (dr < 0);
-                int sgnc = (dc > 0) - (dc < 0);
-                locked_dir = dirFromVec(sgnr, sgnc);
+            if (RobotKit::aligned(dr, dc) && !have_lock) {
+                locked_dir = RobotKit::dirOf(dr, dc);
                 have_lock  = true;
             }
         }
@@ -1123,18 +1128,11 @@ public:
         int cr, cc;
         get_current_location(cr, cc);
 
-        static const std::pair<int,int> dirs[9] = {
-            {0,0},{-1,0},{-1,1},{0,1},{1,1},{1,0},{1,-1},{0,-1},{-1,-1}
-        };
-
         auto alignedWith = [&](int r, int c, int dir) -> bool {
             int dr = r - cr;
             int dc = c - cc;
-            if (!((dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc)))) return false;
-            if (dir == 0) return true;
-            int sgnr = (dr > 0) - (dr < 0);
-            int sgnc = (dc > 0) - (dc < 0);
-            return dirs[dir].first == sgnr && dirs[dir].second == sgnc;
+            if (!RobotKit::aligned(dr, dc)) return false;
+            return dir == 0 || RobotKit::dirOf(dr, dc) == dir;
         };
 
         std::pair<int,int> best = {-1, -1};
@@ -1143,7 +1141,7 @@ public:
         if (locked_dir != 0) {
             for (auto [r, c] : last_seen_this_turn) {
                 if (!alignedWith(r, c, locked_dir)) continue;
-                int d = std::max(std::abs(r - cr), std::abs(c - cc));
+                int d = RobotKit::chebyshev(r - cr, c - cc);
                 if (d < bestd) {
                     bestd = d;
                     best  = {r, c};
@@ -1161,7 +1159,7 @@ public:
         bestd = -1;
         for (auto [r, c] : last_seen_this_turn) {
             if (!alignedWith(r, c, 0)) continue;
-            int d = std::max(std::abs(r - cr), std::abs(c - cc));
+            int d = RobotKit::chebyshev(r - cr, c - cc);
             if (d > bestd) {
                 bestd = d;
                 best  = {r, c};
@@ -1202,7 +1200,7 @@ public:
             if (locked_dir != 0) {
                 dangerLine[locked_dir] += 8;
 
-                int opposite = (locked_dir + 4 - 1) % 8 + 1;
+                int opposite = RobotKit::opposite(locked_dir);
                 dangerLine[opposite] += 3;
             }
         } else if (damagePanicTurns > 0) {
@@ -1245,10 +1243,6 @@ public:
         bool escapeMode = (closeThreat || currentRailThreat || damageThreat);
 
 
-        static const std::pair<int,int> dirs[9] = {
-            {0,0},{-1,0},{-1,1},{0,1},{1,1},{1,0},{1,-1},{0,-1},{-1,-1}
-        };
-
         auto commitMove = [&](int d, int dist) {
             direction = d;
             distance  = (d == 0) ? 0 : dist;
@@ -1268,8 +1262,8 @@ public:
             for (int d = 0; d <= 8; ++d) {
                 int startK = (d == 0 ? 0 : 1);
                 for (int k = startK; k <= maxStep; ++k) {
-                    int fr = cr + dirs[d].first  * k;
-                    int fc = cc + dirs[d].second * k;
+                    int fr = cr + directions[d].first  * k;
+                    int fc = cc + directions[d].second * k;
 
                     if (!inBounds(fr, fc)) break;
 
@@ -1277,8 +1271,8 @@ public:
                     int tr = cr;
                     int tc = cc;
                     for (int step = 1; step <= k; ++step) {
-                        tr += dirs[d].first;
-                        tc += dirs[d].second;
+                        tr += directions[d].first;
+                        tc += directions[d].second;
                         if (!inBounds(tr, tc)) { pathHitsTrap = true; break; }
 
                         if (isKnownTrap(tr, tc)) {
@@ -1309,11 +1303,11 @@ public:
                             int dcNow = ec - cc;
                             int drNew = er - fr;
                             int dcNew = ec - fc;
-                            int chebNow = std::max(std::abs(drNow), std::abs(dcNow));
-                            int chebNew = std::max(std::abs(drNew), std::abs(dcNew));
+                            int chebNow = RobotKit::chebyshev(drNow, dcNow);
+                            int chebNew = RobotKit::chebyshev(drNew, dcNew);
 
-                            bool alignedNow = (drNow == 0) || (dcNow == 0) || (std::abs(drNow) == std::abs(dcNow));
-                            bool alignedNew = (drNew == 0) || (dcNew == 0) || (std::abs(drNew) == std::abs(dcNew));
+                            bool alignedNow = RobotKit::aligned(drNow, dcNow);
+                            bool alignedNew = RobotKit::aligned(drNew, dcNew);
 
                             if (chebNow < bestLiveDistNow) bestLiveDistNow = chebNow;
                             if (chebNew < bestLiveDistNew) bestLiveDistNew = chebNew;
@@ -1334,7 +1328,7 @@ public:
                     }
 
                     if (last_move_dir != 0 && d != 0) {
-                        int opposite = (last_move_dir + 4 - 1) % 8 + 1;
+                        int opposite = RobotKit::opposite(last_move_dir);
                         if (d == opposite) {
                             extra += 2000;
                         }
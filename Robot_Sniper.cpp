@@ -1,42 +1,35 @@
 #include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "SpanRadarRobot.h"
+#include "RobotKit.h"
 #include <vector>
 #include <cmath>
 #include <limits>
 
-class Robot_Sniper : public RobotBase {
+class Robot_Sniper : public RobotBase, public ResettableRobot, public SpanRadarRobot {
 private:
     bool m_hasTarget = false;
     int  m_targetRow = -1;
     int  m_targetCol = -1;
     int  m_radarDir  = 1; // sweep 1-8
 
-    int to_dir(int dr, int dc) const {
-        int sgnr = (dr > 0) - (dr < 0);
-        int sgnc = (dc > 0) - (dc < 0);
-
-        if (sgnr == -1 && sgnc ==  0) return 1;
-        if (sgnr == -1 && sgnc ==  1) return 2;
-        if (sgnr ==  0 && sgnc ==  1) return 3;
-        if (sgnr ==  1 && sgnc ==  1) return 4;
-        if (sgnr ==  1 && sgnc ==  0) return 5;
-        if (sgnr ==  1 && sgnc == -1) return 6;
-        if (sgnr ==  0 && sgnc == -1) return 7;
-        if (sgnr == -1 && sgnc == -1) return 8;
-        return 0;
-    }
-
 public:
     Robot_Sniper() : RobotBase(3, 4, railgun) {
         m_name = "Sniper";
     }
 
+    void reset_for_new_game() override {
+        const Robot_Sniper fresh;
+        *this = fresh;
+    }
+
     void get_radar_direction(int& radar_direction) override {
         if (m_hasTarget) {
             int cr, cc;
             get_current_location(cr, cc);
             int dr = m_targetRow - cr;
             int dc = m_targetCol - cc;
-            int dir = to_dir(dr, dc);
+            int dir = RobotKit::dirOf(dr, dc);
             if (dir != 0) {
                 radar_direction = dir;
                 return;
@@ -47,8 +40,15 @@ public:
     }
 
     void process_radar_results(const std::vector<RadarObj>& radar_results) override {
+        int cr, cc;
+        get_current_location(cr, cc);
+        process_radar_span(radar_results, summarizeRadar(radar_results, cr, cc));
+    }
+
+    void process_radar_span(std::span<const RadarObj> radar_results, const RadarSummary& summary) override {
         m_hasTarget = false;
         m_targetRow = m_targetCol = -1;
+        if (!summary.anyEnemy()) return;
 
         int cr, cc;
         get_current_location(cr, cc);
@@ -61,10 +61,9 @@ public:
             int dr = obj.m_row - cr;
             int dc = obj.m_col - cc;
 
-            bool aligned = (dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc));
-            if (!aligned) continue;
+            if (!RobotKit::aligned(dr, dc)) continue;
 
-            int cheb = std::max(std::abs(dr), std::abs(dc));
+            int cheb = RobotKit::chebyshev(dr, dc);
             if (cheb > bestDist) {
                 bestDist  = cheb;
                 m_targetRow = obj.m_row;
@@ -81,8 +80,7 @@ public:
         get_current_location(cr, cc);
         int dr = m_targetRow - cr;
         int dc = m_targetCol - cc;
-        bool aligned = (dr == 0) || (dc == 0) || (std::abs(dr) == std::abs(dc));
-        if (!aligned) {
+        if (!RobotKit::aligned(dr, dc)) {
             return false;
         }
 
@@ -103,11 +101,11 @@ public:
         if (m_hasTarget) {
             int dr = m_targetRow - cr;
             int dc = m_targetCol - cc;
-            int d  = std::max(std::abs(dr), std::abs(dc));
+            int d  = RobotKit::chebyshev(dr, dc);
 
             // If they're VERY close (< 3), step back a bit
             if (d < 3) {
-                int backDir = to_dir(cr - m_targetRow, cc - m_targetCol);
+                int backDir = RobotKit::dirOf(cr - m_targetRow, cc - m_targetCol);
                 if (backDir != 0) {
                     move_direction = backDir;
                     move_distance  = 1;
@@ -131,7 +129,7 @@ public:
             return;
         }
 
-        int dir = to_dir(dr, dc);
+        int dir = RobotKit::dirOf(dr, dc);
         if (dir != 0) {
             move_direction = dir;
             move_distance  = 1;
@@ -0,0 +1,489 @@
+//SandboxedRobot.cpp
+#include "SandboxedRobot.h"
+#include "SpanRadarRobot.h"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <linux/futex.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <utility>
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the rings need lock-free atomics");
+
+// One direction of a worker's channel: a byte ring with one producer and
+// one consumer. head and tail count bytes written and read and run freely,
+// wrapping at 2^32. A message is a 32-bit length, then that many bytes,
+// which may wrap around the end of `data`. Every push bumps `seq`. That is
+// the futex a consumer with nothing to read sleeps on, and `sleeping` tells
+// the producer whether the wake syscall is needed at all.
+struct SandboxRing {
+    static constexpr uint32_t CAPACITY = 1u << 16;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+    alignas(64) std::atomic<uint32_t> head{0};
+    alignas(64) std::atomic<uint32_t> tail{0};
+    alignas(64) std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> sleeping{0};
+    alignas(64) unsigned char data[CAPACITY];
+
+    // Producer: appends one message made of `parts`; false if it does not fit.
+    bool push(std::initializer_list<std::pair<const void*, size_t>> parts);
+    // Consumer: takes the next message into `out`; false if there is none.
+    bool pop(std::vector<unsigned char>& out);
+    // Consumer: returns once a message is there or `timeout` has passed
+    // (nullptr: no timeout); says which.
+    bool wait(const timespec* timeout);
+
+private:
+    void copyIn(uint32_t at, const void* src, size_t n);
+    void copyOut(uint32_t at, void* dst, size_t n) const;
+    bool readable() const { return head.load(std::memory_order_acquire) != tail.load(std::memory_order_relaxed); }
+};
+
+struct SandboxChannel {
+    SandboxRing requests;       // proxy -> worker
+    SandboxRing replies;        // worker -> proxy
+};
+
+namespace {
+    // Not FUTEX_PRIVATE_FLAG (and so not std::atomic::wait): the word is
+    // shared between processes.
+    long futex(std::atomic<uint32_t>& word, int op, uint32_t value, const timespec* timeout) {
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, value, timeout, nullptr, 0);
+    }
+
+    // Spinning only pays when the other process has a core of its own to
+    // answer on; on one core it would just delay it.
+    const bool SPIN = std::thread::hardware_concurrency() > 1;
+    constexpr int SPIN_LIMIT = 2000;
+
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+void SandboxRing::copyIn(uint32_t at, const void* src, size_t n) {
+    uint32_t i = at & (CAPACITY - 1);
+    size_t first = std::min<size_t>(n, CAPACITY - i);
+    std::memcpy(data + i, src, first);
+    std::memcpy(data, static_cast<const unsigned char*>(src) + first, n - first);
+}
+
+void SandboxRing::copyOut(uint32_t at, void* dst, size_t n) const {
+    uint32_t i = at & (CAPACITY - 1);
+    size_t first = std::min<size_t>(n, CAPACITY - i);
+    std::memcpy(dst, data + i, first);
+    std::memcpy(static_cast<unsigned char*>(dst) + first, data, n - first);
+}
+
+bool SandboxRing::push(std::initializer_list<std::pair<const void*, size_t>> parts) {
+    size_t len = 0;
+    for (const auto& part : parts) len += part.second;
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (len + sizeof(uint32_t) > CAPACITY - (h - t)) return false;
+
+    uint32_t n = static_cast<uint32_t>(len);
+    copyIn(h, &n, sizeof n);
+    h += sizeof n;
+    for (const auto& [src, size] : parts) {
+        copyIn(h, src, size);
+        h += static_cast<uint32_t>(size);
+    }
+    head.store(h, std::memory_order_release);
+    seq.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_seq_cst)) futex(seq, FUTEX_WAKE, 1, nullptr);
+    return true;
+}
+
+bool SandboxRing::pop(std::vector<unsigned char>& out) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) return false;
+    uint32_t n = 0;
+    copyOut(t, &n, sizeof n);
+    out.resize(n);
+    copyOut(t + sizeof n, out.data(), n);
+    tail.store(t + sizeof n + n, std::memory_order_release);
+    return true;
+}
+
+bool SandboxRing::wait(const timespec* timeout) {
+    if (SPIN) {
+        for (int i = 0; i < SPIN_LIMIT; ++i) {
+            if (readable()) return true;
+            cpuRelax();
+        }
+    }
+    uint32_t seen = seq.load(std::memory_order_acquire);
+    if (readable()) return true;
+    // pairs with push(): either it sees `sleeping` and wakes us, or we see its head
+    sleeping.store(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!readable()) futex(seq, FUTEX_WAIT, seen, timeout);
+    sleeping.store(0, std::memory_order_relaxed);
+    return readable();
+}
+
+namespace {
+    enum Op : int32_t { OpHello, OpRadarDir, OpTurn, OpShot, OpMove, OpReset, OpQuit };
+
+    // Every request carries the proxy's RobotBase state, followed for
+    // OpTurn by `hits` radar records.
+    struct Request {
+        int32_t op = OpHello;
+        int32_t health = 0, armor = 0, move = 0, grenades = 0;
+        int32_t row = 0, col = 0, rowMax = 0, colMax = 0;
+        int32_t hits = 0;
+    };
+    struct PackedHit { int32_t type, row, col; };
+    // A scan with more hits than fit in one message is cut short, dropping
+    // the farthest ones (a few thousand; only seen on huge boards).
+    constexpr size_t MAX_HITS = (SandboxRing::CAPACITY - sizeof(uint32_t) - sizeof(Request)) / sizeof(PackedHit);
+
+    struct Reply {
+        int32_t op = OpHello;
+        int32_t radarDir = 0;
+        int32_t shot = 0, shotRow = 0, shotCol = 0;
+        int32_t moved = 0, moveDir = 0, moveDist = 0;
+        // OpHello
+        int32_t move = 0, armor = 0, weapon = 0, character = 'R';
+        char name[48] = {};
+    };
+
+    std::chrono::milliseconds g_timeout{1000};
+
+    // RobotBase is abstract; this is only here to build a fresh one.
+    struct FreshBase : RobotBase {
+        using RobotBase::RobotBase;
+        void get_radar_direction(int&) override {}
+        void process_radar_results(const std::vector<RadarObj>&) override {}
+        bool get_shot_location(int&, int&) override { return false; }
+        void get_move_direction(int&, int&) override {}
+    };
+
+    // Health, armor, grenades and speed only ever go down in a game, so the
+    // real robot catches up with the proxy through its own final setters.
+    void sync(RobotBase& bot, const Request& q) {
+        if (bot.get_health() > q.health) bot.take_damage(bot.get_health() - q.health);
+        if (bot.get_armor() > q.armor) bot.reduce_armor(bot.get_armor() - q.armor);
+        while (bot.get_grenades() > q.grenades) bot.decrement_grenades();
+        if (q.move == 0 && bot.get_move_speed() != 0) bot.disable_movement();
+        bot.move_to(q.row, q.col);
+        bot.set_boundaries(q.rowMax, q.colMax);
+    }
+
+    void sayHello(SandboxChannel& ch, RobotBase& bot) {
+        Reply r;
+        r.move = bot.get_move_speed();
+        r.armor = bot.get_armor();
+        r.weapon = bot.get_weapon();
+        r.character = bot.m_character;
+        std::strncpy(r.name, bot.m_name.c_str(), sizeof r.name - 1);
+        ch.replies.push({{&r, sizeof r}});
+    }
+
+    // The worker process: builds the robot and answers requests until told
+    // to quit. Never returns, and leaves with _exit so nothing of the
+    // parent's (atexit handlers, static destructors) runs twice.
+    [[noreturn]] void serve(SandboxChannel& ch, RobotFactory factory) {
+        RobotBase* bot = factory();
+        SpanRadarRobot* spanRadar = dynamic_cast<SpanRadarRobot*>(bot);
+        sayHello(ch, *bot);
+
+        std::vector<unsigned char> msg;
+        std::vector<RadarObj> hits;
+        for (;;) {
+            while (!ch.requests.pop(msg)) ch.requests.wait(nullptr);
+            Request q;
+            std::memcpy(&q, msg.data(), sizeof q);
+
+            if (q.op == OpQuit) {
+                delete bot;
+                std::cout.flush();
+                std::fflush(nullptr);
+                _exit(0);
+            }
+            if (q.op == OpReset) {
+                if (auto* resettable = dynamic_cast<ResettableRobot*>(bot)) {
+                    resettable->reset_for_new_game();
+                } else {
+                    delete bot;
+                    bot = factory();
+                    spanRadar = dynamic_cast<SpanRadarRobot*>(bot);
+                }
+                sayHello(ch, *bot);
+                continue;
+            }
+
+            sync(*bot, q);
+            Reply r;
+            r.op = q.op;
+            switch (q.op) {
+                case OpRadarDir:
+                    bot->get_radar_direction(r.radarDir);
+                    break;
+                case OpTurn: {
+                    hits.resize(static_cast<size_t>(q.hits));
+                    const unsigned char* in = msg.data() + sizeof q;
+                    for (auto& h : hits) {
+                        PackedHit p;
+                        std::memcpy(&p, in, sizeof p);
+                        in += sizeof p;
+                        h = RadarObj(static_cast<char>(p.type), p.row, p.col);
+                    }
+                    if (spanRadar) spanRadar->process_radar_span(hits, summarizeRadar(hits, q.row, q.col));
+                    else bot->process_radar_results(hits);
+                    r.shot = bot->get_shot_location(r.shotRow, r.shotCol);
+                    if (!r.shot) {
+                        bot->get_move_direction(r.moveDir, r.moveDist);
+                        r.moved = 1;
+                    }
+                    break;
+                }
+                case OpShot:
+                    r.shot = bot->get_shot_location(r.shotRow, r.shotCol);
+                    break;
+                case OpMove:
+                    bot->get_move_direction(r.moveDir, r.moveDist);
+                    r.moved = 1;
+                    break;
+                default:
+                    break;
+            }
+            ch.replies.push({{&r, sizeof r}});
+        }
+    }
+
+    enum class Outcome { Ok, Died, TimedOut };
+
+    bool take(SandboxChannel& ch, Reply& r) {
+        thread_local std::vector<unsigned char> msg;
+        if (!ch.replies.pop(msg)) return false;
+        std::memcpy(&r, msg.data(), std::min(sizeof r, msg.size()));
+        return true;
+    }
+
+    // WNOWAIT leaves a dead worker unreaped, so its pid cannot be reused
+    // before stop() kills and reaps it.
+    bool exited(pid_t pid) {
+        siginfo_t info{};
+        return waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == 0
+            && info.si_pid == pid;
+    }
+
+    // Waits for the worker's reply, checking every few milliseconds that
+    // the worker is still alive.
+    Outcome receive(pid_t pid, SandboxChannel& ch, Reply& r) {
+        const auto deadline = std::chrono::steady_clock::now() + g_timeout;
+        for (;;) {
+            if (take(ch, r)) return Outcome::Ok;
+            auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::nanoseconds::zero()) return Outcome::TimedOut;
+            auto slice = std::min<std::chrono::nanoseconds>(left, std::chrono::milliseconds(10));
+            timespec ts{ static_cast<time_t>(slice.count() / 1000000000), static_cast<long>(slice.count() % 1000000000) };
+            if (ch.replies.wait(&ts)) continue;
+            if (exited(pid)) return take(ch, r) ? Outcome::Ok : Outcome::Died;
+        }
+    }
+}
+
+void SandboxedRobot::setTimeout(std::chrono::milliseconds timeout) {
+    g_timeout = timeout;
+}
+
+SandboxedRobot::Worker SandboxedRobot::spawn(RobotFactory factory, Hello& hello) {
+    void* mem = mmap(nullptr, sizeof(SandboxChannel), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return {};
+    auto* ch = new (mem) SandboxChannel;
+
+    // or the worker starts with a copy of whatever output is still
+    // buffered here, and writes it a second time
+    std::cout.flush();
+    std::fflush(nullptr);
+    const pid_t parent = getpid();
+    pid_t pid = fork();
+    if (pid == 0) {
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != parent) _exit(0);
+        serve(*ch, factory);
+    }
+    Worker w{pid, ch};
+    Reply r;
+    if (pid < 0 || receive(pid, *ch, r) != Outcome::Ok) {
+        if (pid > 0) {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+        ch->~SandboxChannel();
+        munmap(mem, sizeof(SandboxChannel));
+        return {};
+    }
+    hello.move = r.move;
+    hello.armor = r.armor;
+    hello.weapon = static_cast<WeaponType>(r.weapon);
+    hello.character = static_cast<char>(r.character);
+    hello.name = r.name;
+    return w;
+}
+
+RobotBase* SandboxedRobot::create(RobotFactory factory) {
+    Hello hello;
+    Worker worker = spawn(factory, hello);
+    if (worker.pid < 0) std::cerr << "Warning: could not start a sandbox worker; the robot forfeits\n";
+    return new SandboxedRobot(factory, worker, hello);
+}
+
+SandboxedRobot::SandboxedRobot(RobotFactory factory, Worker worker, const Hello& hello)
+    : RobotBase(hello.move, hello.armor, hello.weapon),
+      m_factory(factory), m_worker(worker), m_hello(hello)
+{
+    restoreBase();
+}
+
+SandboxedRobot::~SandboxedRobot() { stop(true); }
+
+// A fresh RobotBase, as the real robot's constructor left it.
+void SandboxedRobot::restoreBase() {
+    static_cast<RobotBase&>(*this) = FreshBase(m_hello.move, m_hello.armor, m_hello.weapon);
+    m_name = m_hello.name;
+    m_character = m_hello.character;
+    set_boundaries(0, 0);
+    m_haveShot = m_haveMove = m_shot = false;
+    m_forfeited = false;
+}
+
+// Graceful: asks the worker to quit, which runs the robot's destructor,
+// and gives it the timeout to do so before killing it.
+void SandboxedRobot::stop(bool graceful) {
+    if (m_worker.pid > 0) {
+        bool reaped = false;
+        Request q;
+        q.op = OpQuit;
+        if (graceful && m_worker.channel->requests.push({{&q, sizeof q}})) {
+            const auto deadline = std::chrono::steady_clock::now() + g_timeout;
+            while (!(reaped = waitpid(m_worker.pid, nullptr, WNOHANG) == m_worker.pid)
+                   && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        if (!reaped) {
+            kill(m_worker.pid, SIGKILL);
+            waitpid(m_worker.pid, nullptr, 0);
+        }
+    }
+    if (m_worker.channel) {
+        m_worker.channel->~SandboxChannel();
+        munmap(m_worker.channel, sizeof(SandboxChannel));
+    }
+    m_worker = {};
+}
+
+void SandboxedRobot::lose(const char* what) {
+    std::cerr << "Warning: robot " << m_name << " " << what << "; it forfeits\n";
+    stop(false);
+    ++m_failures;
+    m_forfeited = true;
+}
+
+void SandboxedRobot::reset_for_new_game() {
+    if (m_worker.pid > 0) {
+        Request q;
+        q.op = OpReset;
+        Reply r;
+        if (!m_worker.channel->requests.push({{&q, sizeof q}})
+            || receive(m_worker.pid, *m_worker.channel, r) != Outcome::Ok) {
+            stop(false);
+            ++m_failures;
+        }
+    }
+    if (m_worker.pid < 0) m_worker = spawn(m_factory, m_hello);
+    restoreBase();
+}
+
+// One round trip; the answer lands in the m_ fields. Without a worker, or
+// when it fails, the robot forfeits and the answer is "nothing".
+bool SandboxedRobot::call(int op, const std::vector<RadarObj>* hits) {
+    m_radarDir = 0;
+    m_shot = false;
+    m_shotRow = m_shotCol = m_moveDir = m_moveDist = 0;
+    if (m_worker.pid < 0) {
+        m_forfeited = true;
+        return false;
+    }
+
+    Request q;
+    q.op = op;
+    q.health = get_health();
+    q.armor = get_armor();
+    q.move = get_move_speed();
+    q.grenades = get_grenades();
+    get_current_location(q.row, q.col);
+    q.rowMax = m_board_row_max;
+    q.colMax = m_board_col_max;
+
+    thread_local std::vector<PackedHit> packed;
+    packed.clear();
+    if (hits) {
+        size_t n = std::min(hits->size(), MAX_HITS);
+        for (size_t i = 0; i < n; ++i)
+            packed.push_back({ (*hits)[i].m_type, (*hits)[i].m_row, (*hits)[i].m_col });
+        q.hits = static_cast<int32_t>(n);
+    }
+
+    Reply r;
+    Outcome outcome = Outcome::Died;
+    if (m_worker.channel->requests.push({{&q, sizeof q}, {packed.data(), packed.size() * sizeof(PackedHit)}}))
+        outcome = receive(m_worker.pid, *m_worker.channel, r);
+    if (outcome != Outcome::Ok) {
+        lose(outcome == Outcome::TimedOut ? "did not answer in time" : "crashed");
+        return false;
+    }
+    m_radarDir = r.radarDir;
+    m_shot = r.shot != 0;
+    m_shotRow = r.shotRow;
+    m_shotCol = r.shotCol;
+    m_moveDir = r.moveDir;
+    m_moveDist = r.moveDist;
+    return true;
+}
+
+void SandboxedRobot::get_radar_direction(int& radar_direction) {
+    m_haveShot = m_haveMove = false;
+    call(OpRadarDir);
+    radar_direction = m_radarDir;
+}
+
+void SandboxedRobot::process_radar_results(const std::vector<RadarObj>& radar_results) {
+    m_haveShot = call(OpTurn, &radar_results);
+    // the worker asks for the move only when there is no shot, like the arena
+    m_haveMove = m_haveShot && !m_shot;
+}
+
+bool SandboxedRobot::get_shot_location(int& shot_row, int& shot_col) {
+    if (!m_haveShot) call(OpShot);
+    m_haveShot = false;
+    shot_row = m_shotRow;
+    shot_col = m_shotCol;
+    return m_shot;
+}
+
+void SandboxedRobot::get_move_direction(int& direction, int& distance) {
+    if (!m_haveMove) call(OpMove);
+    m_haveMove = false;
+    direction = m_moveDir;
+    distance = m_moveDist;
+}
@@ -0,0 +1,89 @@
+//SandboxedRobot.h
+#pragma once
+#include <chrono>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+#include "RobotBase.h"
+#include "ResettableRobot.h"
+#include "ForfeitingRobot.h"
+
+struct SandboxChannel;
+
+// Runs a robot in a forked worker process, so a crash or a hang costs that
+// robot its game instead of taking the whole tournament down. The arena
+// only ever sees this proxy. Calls go to the real robot in the worker over
+// two single-producer single-consumer rings in memory shared by the two
+// processes (see SandboxedRobot.cpp), sleeping on a futex when the other
+// side is slow.
+//
+// A turn is two round trips. The first asks for the radar direction. The
+// second sends the hits, and the worker answers with the shot and, if
+// there is no shot, the move, the way the arena asks for them. The proxy's
+// RobotBase is the one the arena damages and moves. Its state goes with
+// every request and is applied to the real robot's base, so the robot
+// sees what it would see in process. Statics (Reaper's learning state)
+// are per worker.
+//
+// A worker that dies, or takes longer than the timeout to answer, is
+// killed and the robot forfeits: it raises forfeited(), and the arena
+// drops its health to 0 and records the death when it applies the robot's
+// turn. A fresh worker takes over when the pool
+// resets the robot for its next game. POSIX (fork, mmap); the futex makes
+// it Linux-only.
+class SandboxedRobot : public RobotBase, public ResettableRobot, public ForfeitingRobot {
+public:
+    // A proxy for a robot from `factory`; fits RobotPool::acquire as a wrapper.
+    static RobotBase* create(RobotFactory factory);
+    // How long a worker gets to answer one request. Shared by every proxy.
+    static void setTimeout(std::chrono::milliseconds timeout);
+
+    ~SandboxedRobot() override;
+    SandboxedRobot(const SandboxedRobot&) = delete;
+    SandboxedRobot& operator=(const SandboxedRobot&) = delete;
+
+    void reset_for_new_game() override;
+
+    void get_radar_direction(int& radar_direction) override;
+    void process_radar_results(const std::vector<RadarObj>& radar_results) override;
+    bool get_shot_location(int& shot_row, int& shot_col) override;
+    void get_move_direction(int& direction, int& distance) override;
+
+    bool forfeited() const override { return m_forfeited; }
+
+    // Workers this proxy has lost so far.
+    int failures() const { return m_failures; }
+
+private:
+    // What the worker reports about its robot when it starts or resets.
+    struct Hello {
+        int move = 2, armor = 0;
+        WeaponType weapon = railgun;
+        char character = 'R';
+        std::string name;
+    };
+    struct Worker {
+        pid_t pid = -1;                  // -1: none, the robot forfeits its next turn
+        SandboxChannel* channel = nullptr;
+    };
+    SandboxedRobot(RobotFactory factory, Worker worker, const Hello& hello);
+
+    static Worker spawn(RobotFactory factory, Hello& hello);
+    void stop(bool graceful);
+    void lose(const char* what);
+    bool call(int op, const std::vector<RadarObj>* hits = nullptr);
+    void restoreBase();
+
+    RobotFactory m_factory;
+    Worker m_worker;
+    Hello m_hello;
+    int m_failures = 0;
+    bool m_forfeited = false;           // this game; only the proxy's own thread writes it
+
+    // What the worker answered to the radar hits, for the
+    // get_shot_location and get_move_direction calls that follow.
+    bool m_haveShot = false, m_haveMove = false;
+    int m_radarDir = 0;
+    bool m_shot = false;
+    int m_shotRow = 0, m_shotCol = 0, m_moveDir = 0, m_moveDist = 0;
+};
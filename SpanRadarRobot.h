@@ -0,0 +1,47 @@
+//SpanRadarRobot.h
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <span>
+#include "RadarObj.h"
+
+// What the arena already knows about a scan, so robots don't each walk it
+// again to find out. A scan follows one ray out from the robot, so every
+// hit is aligned with it and hits come nearest first.
+struct RadarSummary {
+    int enemies = 0;            // living robots in the scan
+    int nearestEnemy = -1;      // index of the closest one in the span, or -1
+    int nearestDistance = 0;    // its Chebyshev distance from the scanning robot
+
+    bool anyEnemy() const { return enemies > 0; }
+};
+
+// Terrain and corpses; any other radar type is a living robot.
+inline bool radarIsEnemy(char t) {
+    return !(t == '.' || t == 'M' || t == 'P' || t == 'F' || t == 'X');
+}
+
+inline RadarSummary summarizeRadar(std::span<const RadarObj> hits, int row, int col) {
+    RadarSummary s;
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if (!radarIsEnemy(hits[i].m_type)) continue;
+        if (s.enemies++ == 0) {
+            s.nearestEnemy = static_cast<int>(i);
+            s.nearestDistance = std::max(std::abs(hits[i].m_row - row), std::abs(hits[i].m_col - col));
+        }
+    }
+    return s;
+}
+
+// Opt-in radar hook for robots (see ResettableRobot for the pattern). The
+// arena looks for it with dynamic_cast when the robot is added and, if
+// present, calls this instead of process_radar_results: the hits are a
+// view of the arena's own scan buffer, valid only during the call, so
+// nothing is copied or allocated. Robots without it are unaffected.
+class SpanRadarRobot {
+public:
+    virtual void process_radar_span(std::span<const RadarObj> hits, const RadarSummary& summary) = 0;
+
+protected:
+    ~SpanRadarRobot() = default;
+};
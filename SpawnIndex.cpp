@@ -0,0 +1,107 @@
+//SpawnIndex.cpp
+#include "SpawnIndex.h"
+#include "Board.h"
+#include <algorithm>
+#include <cstdint>
+
+template <class BoardT>
+void SpawnIndex::build(const BoardT& board) {
+    m_rows = board.rows();
+    m_cols = board.cols();
+    m_free.clear();
+    m_pos.assign(static_cast<size_t>(m_rows) * m_cols, -1);
+    for (int r = 0; r < m_rows; ++r) {
+        for (int c = 0; c < m_cols; ++c) {
+            if (board.get(r, c) != Tile::Empty) continue;
+            int cell = r * m_cols + c;
+            m_pos[cell] = static_cast<int>(m_free.size());
+            m_free.push_back(cell);
+        }
+    }
+}
+
+template void SpawnIndex::build(const Board&);
+template void SpawnIndex::build(const StandardBoard&);
+
+void SpawnIndex::remove(int cell) {
+    int at = m_pos[cell];
+    if (at < 0) return;
+    int last = m_free.back();
+    m_free[at] = last;
+    m_pos[last] = at;
+    m_free.pop_back();
+    m_pos[cell] = -1;
+}
+
+void SpawnIndex::claim(int r, int c) {
+    for (int dr = -1; dr <= 1; ++dr) {
+        for (int dc = -1; dc <= 1; ++dc) {
+            int nr = r + dr, nc = c + dc;
+            if (nr < 0 || nr >= m_rows || nc < 0 || nc >= m_cols) continue;
+            remove(nr * m_cols + nc);
+        }
+    }
+}
+
+// Depth-first over the free cells grouped by aligned 2x2 block. Two
+// robots can never share a block, so each block takes one of its cells or
+// none, and `placed + blocks left` bounds what a branch can still reach:
+// most dead ends (and every overfull roster) are cut at once.
+bool SpawnIndex::pack(size_t n, std::vector<int>& cells, long budget) const {
+    cells.clear();
+    if (n == 0) return true;
+
+    const int blockCols = (m_cols + 1) / 2;
+    auto blockOf = [&](int cell) { return (cell / m_cols / 2) * blockCols + (cell % m_cols) / 2; };
+    std::vector<int> order(m_free);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        int ba = blockOf(a), bb = blockOf(b);
+        return ba != bb ? ba < bb : a < b;
+    });
+    std::vector<size_t> begin;              // block k holds order[begin[k], begin[k+1])
+    for (size_t i = 0; i < order.size(); ++i)
+        if (i == 0 || blockOf(order[i]) != blockOf(order[i - 1])) begin.push_back(i);
+    const size_t blocks = begin.size();
+    begin.push_back(order.size());
+    if (blocks < n) return false;
+
+    std::vector<uint8_t> near(static_cast<size_t>(m_rows) * m_cols, 0);   // placed robots touching each cell
+    auto mark = [&](int cell, int delta) {
+        int r = cell / m_cols, c = cell % m_cols;
+        for (int nr = std::max(0, r - 1); nr <= std::min(m_rows - 1, r + 1); ++nr)
+            for (int nc = std::max(0, c - 1); nc <= std::min(m_cols - 1, c + 1); ++nc)
+                near[nr * m_cols + nc] += delta;
+    };
+
+    struct Frame { size_t block; size_t choice; int cell; };   // choice == block size: leave it empty
+    std::vector<Frame> stack{ { 0, 0, -1 } };
+    while (!stack.empty()) {
+        if (cells.size() == n) return true;
+        Frame& f = stack.back();
+        if (f.cell >= 0) {                   // back from trying f.cell
+            mark(f.cell, -1);
+            cells.pop_back();
+            f.cell = -1;
+        }
+        if (f.block == blocks || cells.size() + (blocks - f.block) < n || --budget < 0) {
+            if (budget < 0) break;
+            stack.pop_back();
+            continue;
+        }
+        const size_t size = begin[f.block + 1] - begin[f.block];
+        while (f.choice < size && near[order[begin[f.block] + f.choice]]) ++f.choice;
+        const size_t next = f.block + 1;
+        if (f.choice < size) {
+            int cell = order[begin[f.block] + f.choice++];
+            mark(cell, +1);
+            cells.push_back(cell);
+            f.cell = cell;
+        } else if (f.choice++ > size) {
+            stack.pop_back();
+            continue;
+        }
+        stack.push_back({ next, 0, -1 });
+    }
+    cells.clear();
+    return false;
+}
@@ -0,0 +1,43 @@
+//SpawnIndex.h
+#pragma once
+#include <random>
+#include <vector>
+
+// The set of cells a robot may still spawn on: not an obstacle, not occupied
+// and not next to a robot. Cells live in a dense array with a reverse
+// position map, so picking a uniform random cell is O(1) and claiming a
+// cell (which retires it and its 8 neighbours) is O(1) by swap-remove.
+class SpawnIndex {
+public:
+    // Every non-obstacle cell of `board` starts free.
+    template <class BoardT>
+    void build(const BoardT& board);
+    bool empty() const { return m_free.empty(); }
+    size_t size() const { return m_free.size(); }
+
+    // Uniformly random free cell; the index must not be empty.
+    template <typename Rng>
+    void pick(Rng& rng, int& r, int& c) const {
+        std::uniform_int_distribution<size_t> dist(0, m_free.size() - 1);
+        int cell = m_free[dist(rng)];
+        r = cell / m_cols;
+        c = cell % m_cols;
+    }
+
+    // A robot now stands at (r, c): it and its neighbours stop being free.
+    void claim(int r, int c);
+
+    // Finds n free cells no two of which touch, by exhaustive search, for
+    // when random picks have boxed themselves in. Cells go to `cells`
+    // (ids r*cols + c, in no random order). False when no such n cells
+    // exist, or in the rare case the search gives up after `budget` steps
+    // without settling it either way.
+    bool pack(size_t n, std::vector<int>& cells, long budget = 10'000'000) const;
+
+private:
+    void remove(int cell);
+
+    int m_rows = 0, m_cols = 0;
+    std::vector<int> m_free;   // free cell ids (r*cols + c), unordered
+    std::vector<int> m_pos;    // cell id -> index in m_free, or -1
+};
@@ -0,0 +1,233 @@
+//Stalemate.cpp
+#include "Stalemate.h"
+#include "Arena.h"
+#include <algorithm>
+
+namespace {
+    uint64_t splitmix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // How far (Chebyshev) a weapon can reach from where its robot stands.
+    // Collisions need adjacency, so every robot has at least 1.
+    int weaponReach(WeaponType w) {
+        switch (w) {
+            case flamethrower: return 5;    // 4 steps out, cone 1 wide, diagonal cone adds one
+            case grenade:      return 7;    // thrown up to 6 away (Manhattan) plus the blast
+            default:           return 1;    // hammer, and railgun off its lines
+        }
+    }
+
+    // The cells some robots can reach, and what they carry.
+    struct Unit {
+        std::vector<int> cells;
+        int robots = 0;
+        int reach = 1;                 // largest weaponReach among them
+        bool railgun = false;
+        int r0, c0, r1, c1;            // bounding box of cells
+    };
+
+    // Does anything of another unit lie within `u.reach` of `u`'s cells?
+    // Square dilation of u's cells, separable (rows, then columns), over
+    // u's bounding box grown by the reach.
+    template <class BoardT>
+    bool reachesOther(const Unit& u, int self, const BoardT& b, const std::vector<int>& unitAt,
+                      std::vector<char>& mask, std::vector<char>& tmp, std::vector<char>& grown) {
+        const int d = u.reach;
+        const int top = std::max(0, u.r0 - d), left = std::max(0, u.c0 - d);
+        const int bottom = std::min(b.rows() - 1, u.r1 + d), right = std::min(b.cols() - 1, u.c1 + d);
+        const int h = bottom - top + 1, w = right - left + 1;
+        mask.assign(static_cast<size_t>(h) * w, 0);
+        for (int cell : u.cells)
+            mask[static_cast<size_t>(cell / b.cols() - top) * w + (cell % b.cols() - left)] = 1;
+
+        tmp.assign(mask.size(), 0);
+        for (int r = 0; r < h; ++r) {
+            const char* in = &mask[static_cast<size_t>(r) * w];
+            char* out = &tmp[static_cast<size_t>(r) * w];
+            int last = -d - 1;                       // nearest set column at or left of c
+            for (int c = 0; c < w; ++c) { if (in[c]) last = c; if (c - last <= d) out[c] = 1; }
+            last = w + d;
+            for (int c = w - 1; c >= 0; --c) { if (in[c]) last = c; if (last - c <= d) out[c] = 1; }
+        }
+        grown.assign(mask.size(), 0);
+        for (int c = 0; c < w; ++c) {
+            int last = -d - 1;
+            for (int r = 0; r < h; ++r) {
+                if (tmp[static_cast<size_t>(r) * w + c]) last = r;
+                if (r - last <= d) grown[static_cast<size_t>(r) * w + c] = 1;
+            }
+            last = h + d;
+            for (int r = h - 1; r >= 0; --r) {
+                if (tmp[static_cast<size_t>(r) * w + c]) last = r;
+                if (last - r <= d) grown[static_cast<size_t>(r) * w + c] = 1;
+            }
+        }
+
+        for (int r = 0; r < h; ++r)
+            for (int c = 0; c < w; ++c) {
+                if (!grown[static_cast<size_t>(r) * w + c]) continue;
+                int owner = unitAt[b.index(top + r, left + c)];
+                if (owner >= 0 && owner != self) return true;
+            }
+        return false;
+    }
+}
+
+uint64_t Stalemate::robotKey(int idx, int r, int c, int health, int armor, int grenades,
+                             bool alive, bool trapped) {
+    uint64_t packed = static_cast<uint64_t>(static_cast<uint16_t>(r))
+                    | static_cast<uint64_t>(static_cast<uint16_t>(c)) << 16
+                    | static_cast<uint64_t>(health & 0x3FF) << 32
+                    | static_cast<uint64_t>(armor & 0x3FF) << 42
+                    | static_cast<uint64_t>(alive) << 52
+                    | static_cast<uint64_t>(trapped) << 53
+                    | static_cast<uint64_t>(grenades & 0x3FF) << 54;
+    return splitmix64(splitmix64(static_cast<uint64_t>(idx)) ^ packed);
+}
+
+template <class BoardT>
+bool Stalemate::harmless(const BoardT& board, std::span<const RobotEntry> robots,
+                         const std::vector<int>& occupancy) {
+    const int rows = board.rows(), cols = board.cols();
+    const int n = rows * cols;
+    auto isLive = [&](const RobotEntry& e) { return e.alive && e.bot->get_health() > 0; };
+
+    // open cells: passable and not holding a corpse (corpses never move)
+    std::vector<char> open(n, 0);
+    for (int cell = 0; cell < n; ++cell) {
+        Tile t = board.at(cell);
+        int idx = occupancy[cell];
+        bool corpse = idx >= 0 && !isLive(robots[idx]);
+        open[cell] = (t != Tile::Mound && t != Tile::Pit && !corpse);
+    }
+
+    // label connected open regions (8-neighbour, as robots move)
+    std::vector<int> label(n, -1);
+    std::vector<int> stack;
+    int regions = 0;
+    for (int start = 0; start < n; ++start) {
+        if (!open[start] || label[start] >= 0) continue;
+        label[start] = regions;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            int r = cell / cols, c = cell % cols;
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc) {
+                    int nr = r + dr, nc = c + dc;
+                    if ((!dr && !dc) || !board.inBounds(nr, nc)) continue;
+                    int next = board.index(nr, nc);
+                    if (open[next] && label[next] < 0) { label[next] = regions; stack.push_back(next); }
+                }
+        }
+        ++regions;
+    }
+
+    // one unit per occupied region (its cells plus the pits on its edge),
+    // and one per trapped robot
+    std::vector<Unit> units;
+    std::vector<int> unitOfRegion(regions, -1);
+    std::vector<int> unitAt(n, -1);
+    auto claim = [&](int cell, int id) {
+        // a pit two units can both fall into is a place they can meet
+        if (unitAt[cell] >= 0 && unitAt[cell] != id) return false;
+        unitAt[cell] = id;
+        return true;
+    };
+    for (const auto& e : robots) {
+        if (!isLive(e)) continue;
+        int cell = board.index(e.r, e.c);
+        int id;
+        if (e.trappedInPit) {
+            id = static_cast<int>(units.size());
+            units.emplace_back();
+            units.back().cells.push_back(cell);
+            if (!claim(cell, id)) return false;
+        } else {
+            if (label[cell] < 0) return false;       // standing somewhere odd; don't guess
+            int& slot = unitOfRegion[label[cell]];
+            if (slot < 0) {
+                slot = id = static_cast<int>(units.size());
+                units.emplace_back();
+                Unit& fresh = units.back();
+                for (int k = 0; k < n; ++k) {
+                    if (label[k] != label[cell]) continue;
+                    // a mobile robot that can walk onto a flame can still be hurt
+                    if (board.at(k) == Tile::Flame) return false;
+                    fresh.cells.push_back(k);
+                    unitAt[k] = id;
+                }
+                for (size_t i = 0, open_cells = fresh.cells.size(); i < open_cells; ++i) {
+                    int r = fresh.cells[i] / cols, c = fresh.cells[i] % cols;
+                    for (int dr = -1; dr <= 1; ++dr)
+                        for (int dc = -1; dc <= 1; ++dc) {
+                            int nr = r + dr, nc = c + dc;
+                            if (!board.inBounds(nr, nc)) continue;
+                            int p = board.index(nr, nc);
+                            if (board.at(p) != Tile::Pit || unitAt[p] == id) continue;
+                            if (!claim(p, id)) return false;
+                            fresh.cells.push_back(p);
+                        }
+                }
+            }
+            id = slot;
+        }
+        Unit& u = units[id];
+        // two robots free to roam the same region can always meet
+        if (++u.robots > 1) return false;
+        WeaponType w = e.bot->get_weapon();
+        u.reach = std::max(u.reach, weaponReach(w));
+        u.railgun = u.railgun || w == railgun;
+    }
+
+    // railgun shots cross the whole board along rows, columns and diagonals:
+    // per line, which unit touches it (-2 once two different units do)
+    const int diagonals = rows + cols - 1;
+    std::vector<int> lineOwner(static_cast<size_t>(rows) + cols + 2 * diagonals, -1);
+    auto touch = [&](int line, int id) {
+        int& o = lineOwner[line];
+        if (o == -1) o = id;
+        else if (o != id) o = -2;
+    };
+    auto linesOf = [&](int cell, int out[4]) {
+        int r = cell / cols, c = cell % cols;
+        out[0] = r;
+        out[1] = rows + c;
+        out[2] = rows + cols + (r - c + cols - 1);
+        out[3] = rows + cols + diagonals + (r + c);
+    };
+    for (int id = 0; id < static_cast<int>(units.size()); ++id) {
+        Unit& u = units[id];
+        u.r0 = rows; u.c0 = cols; u.r1 = -1; u.c1 = -1;
+        for (int cell : u.cells) {
+            int r = cell / cols, c = cell % cols;
+            u.r0 = std::min(u.r0, r); u.r1 = std::max(u.r1, r);
+            u.c0 = std::min(u.c0, c); u.c1 = std::max(u.c1, c);
+            int lines[4];
+            linesOf(cell, lines);
+            for (int l : lines) touch(l, id);
+        }
+    }
+
+    std::vector<char> mask, tmp, grown;
+    for (int id = 0; id < static_cast<int>(units.size()); ++id) {
+        const Unit& u = units[id];
+        if (u.railgun) {
+            for (int cell : u.cells) {
+                int lines[4];
+                linesOf(cell, lines);
+                for (int l : lines) if (lineOwner[l] == -2) return false;
+            }
+        }
+        if (reachesOther(u, id, board, unitAt, mask, tmp, grown)) return false;
+    }
+    return true;
+}
+
+template bool Stalemate::harmless(const Board&, std::span<const RobotEntry>, const std::vector<int>&);
+template bool Stalemate::harmless(const StandardBoard&, std::span<const RobotEntry>, const std::vector<int>&);
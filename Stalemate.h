@@ -0,0 +1,29 @@
+//Stalemate.h
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Board.h"
+
+struct RobotEntry;
+
+// Early stalemate detection, beyond "no damage for STALEMATE_ROUNDS".
+namespace Stalemate {
+    // Zobrist-style key for one robot's observable state. The arena state
+    // hash is the XOR of every robot's key, so a robot that changes is
+    // updated with two XORs. Keys come from splitmix64 over the robot's
+    // slot and packed state rather than a stored random table.
+    uint64_t robotKey(int idx, int r, int c, int health, int armor, int grenades,
+                      bool alive, bool trapped);
+
+    // True if no living robot can ever damage another one, or itself via a
+    // flame tile, from here on. Each robot can at most reach the cells
+    // connected to it through non-mound, corpse-free cells (a pit ends the
+    // path, a trapped robot reaches only its own cell). Two robots are
+    // harmless to each other if no reachable pair of cells is aligned (for
+    // a railgun) or within weapon or collision range. Over-approximates
+    // reach, so a "true" is a proof; "false" only means not proven.
+    template <class BoardT>
+    bool harmless(const BoardT& board, std::span<const RobotEntry> robots,
+                  const std::vector<int>& occupancy);
+}
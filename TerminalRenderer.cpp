@@ -0,0 +1,170 @@
+//TerminalRenderer.cpp
+#include "TerminalRenderer.h"
+#include <cerrno>
+#include <charconv>
+#include <unistd.h>
+
+namespace {
+    // screen layout (1-based): round title, column header, one line per
+    // board row with 3 columns per cell, a blank line, then one stat line
+    // per robot
+    constexpr int BOARD_TOP  = 3;
+    constexpr int BOARD_LEFT = 5;
+    constexpr int CELL_W     = 3;
+
+    const char* weaponName(int w) {
+        switch (w) {
+            case 0: return "flamethrower";
+            case 1: return "railgun";
+            case 2: return "grenade";
+            case 3: return "hammer";
+        }
+        return "unknown";
+    }
+
+    void appendInt(std::string& s, int v) {
+        char buf[16];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v);
+        s.append(buf, res.ptr);
+    }
+
+    void appendPadded(std::string& s, int v, int width) {
+        char buf[16];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v);
+        for (int n = static_cast<int>(res.ptr - buf); n < width; ++n) s.push_back(' ');
+        s.append(buf, res.ptr);
+    }
+}
+
+void TerminalRenderer::putInt(int v) { appendInt(m_out, v); }
+
+void TerminalRenderer::moveTo(int line, int col) {
+    if (line == m_curLine && col == m_curCol) return;
+    m_out += "\x1b[";
+    putInt(line);
+    m_out.push_back(';');
+    putInt(col);
+    m_out.push_back('H');
+    m_curLine = line;
+    m_curCol  = col;
+}
+
+void TerminalRenderer::formatStats(const FrameRobot& rb, std::string& line) const {
+    line.clear();
+    line.push_back('[');
+    line.push_back(rb.glyph);
+    line.push_back(rb.idGlyph);
+    line += "] ";
+    line += rb.name;
+    line += ":   H: ";   appendInt(line, rb.health);
+    line += "  W: ";     line += weaponName(rb.weapon);
+    line += "  A: ";     appendInt(line, rb.armor);
+    line += "  M: ";     appendInt(line, rb.move);
+    line += "  at: (";   appendInt(line, rb.r);
+    line.push_back(',');  appendInt(line, rb.c);
+    line += ") ";
+    if (!rb.alive) line += "  [DEAD]";
+}
+
+void TerminalRenderer::fullRedraw(const ArenaFrame& f) {
+    m_out += "\x1b[H\x1b[2J=== Round ";
+    putInt(f.round);
+    m_out += " ===\n    ";
+    for (int c = 0; c < f.cols; ++c) {
+        appendPadded(m_out, c % 100, 2);
+        m_out.push_back(' ');
+    }
+    m_out.push_back('\n');
+    for (int r = 0; r < f.rows; ++r) {
+        appendPadded(m_out, r, 3);
+        m_out.push_back(' ');
+        for (int c = 0; c < f.cols; ++c) {
+            m_out.append(f.cell(r, c), 2);
+            m_out.push_back(' ');
+        }
+        m_out.push_back('\n');
+    }
+    m_out.push_back('\n');
+
+    m_prevStats.resize(f.robots.size());
+    for (size_t i = 0; i < f.robots.size(); ++i) {
+        formatStats(f.robots[i], m_prevStats[i]);
+        m_out += m_prevStats[i];
+        m_out.push_back('\n');
+    }
+
+    m_prevCells = f.cells;
+    m_rows = f.rows;
+    m_cols = f.cols;
+    m_prevRound = f.round;
+    m_curLine = BOARD_TOP + f.rows + 1 + static_cast<int>(f.robots.size());
+    m_curCol = 1;
+    m_valid = true;
+}
+
+void TerminalRenderer::render(const ArenaFrame& f) {
+    m_out.clear();
+
+    if (!m_valid || f.rows != m_rows || f.cols != m_cols ||
+        f.robots.size() != m_prevStats.size()) {
+        fullRedraw(f);
+        flush();
+        return;
+    }
+
+    if (f.round != m_prevRound) {
+        moveTo(1, 1);
+        m_out += "=== Round ";
+        putInt(f.round);
+        m_out += " ===\x1b[K";
+        m_curCol = -1;
+        m_prevRound = f.round;
+    }
+
+    for (int r = 0; r < f.rows; ++r) {
+        const char* now  = f.cell(r, 0);
+        char*       prev = &m_prevCells[2 * static_cast<size_t>(r) * f.cols];
+        for (int c = 0; c < f.cols; ++c, now += 2, prev += 2) {
+            if (now[0] == prev[0] && now[1] == prev[1]) continue;
+            int line = BOARD_TOP + r;
+            int col  = BOARD_LEFT + CELL_W * c;
+            if (line == m_curLine && col == m_curCol + 1) {
+                m_out.push_back(' ');   // cheaper than an escape for the next cell over
+                m_curCol = col;
+            }
+            moveTo(line, col);
+            m_out.append(now, 2);
+            m_curCol += 2;
+            prev[0] = now[0];
+            prev[1] = now[1];
+        }
+    }
+
+    int statsTop = BOARD_TOP + f.rows + 1;
+    for (size_t i = 0; i < f.robots.size(); ++i) {
+        formatStats(f.robots[i], m_line);
+        if (m_line == m_prevStats[i]) continue;
+        moveTo(statsTop + static_cast<int>(i), 1);
+        m_out += m_line;
+        m_out += "\x1b[K";
+        m_curCol = -1;
+        m_prevStats[i].assign(m_line);
+    }
+
+    moveTo(statsTop + static_cast<int>(f.robots.size()), 1);
+    flush();
+}
+
+void TerminalRenderer::flush() {
+    const char* p = m_out.data();
+    size_t left = m_out.size();
+    while (left > 0) {
+        ssize_t n = ::write(m_fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+}
@@ -0,0 +1,36 @@
+//TerminalRenderer.h
+#pragma once
+#include <string>
+#include <vector>
+#include "ArenaFrame.h"
+
+// Incremental ANSI renderer for live viewing. The first frame (or a board
+// size change) clears the screen and draws everything; later frames emit
+// only the cells and stat lines that changed, positioned with cursor
+// escapes. Each frame is assembled in one reusable buffer and sent with a
+// single write().
+class TerminalRenderer {
+public:
+    explicit TerminalRenderer(int fd = 1) : m_fd(fd) {}
+
+    void render(const ArenaFrame& frame);
+    // Forces the next render() to redraw the whole screen.
+    void invalidate() { m_valid = false; }
+
+private:
+    void moveTo(int line, int col);
+    void putInt(int v);
+    void formatStats(const FrameRobot& rb, std::string& line) const;
+    void fullRedraw(const ArenaFrame& frame);
+    void flush();
+
+    int m_fd;
+    bool m_valid = false;
+    int m_rows = 0, m_cols = 0;
+    int m_curLine = -1, m_curCol = -1;   // where the terminal cursor is, 1-based
+    std::string m_out;
+    std::vector<char> m_prevCells;
+    std::vector<std::string> m_prevStats;
+    std::string m_line;
+    int m_prevRound = -1;
+};
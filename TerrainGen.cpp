@@ -0,0 +1,115 @@
+//TerrainGen.cpp
+#include "TerrainGen.h"
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace {
+    const int DR[4] = {-1, 0, 1, 0};
+    const int DC[4] = { 0, 1, 0,-1};
+
+    // Lays `count` tiles as segments: each starts on a random empty cell
+    // and runs in one axis direction for a random length. If `turnChance`
+    // is non-zero a segment may bend 90 degrees, which makes wall clusters.
+    template <class BoardT>
+    int segments(BoardT& board, Tile tile, int count, std::mt19937& rng,
+                 int minLen, int maxLen, double turnChance)
+    {
+        std::uniform_int_distribution<int> cellDist(0, board.size() - 1);
+        std::uniform_int_distribution<int> dirDist(0, 3);
+        std::uniform_int_distribution<int> lenDist(minLen, maxLen);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        int placed = 0;
+        // segments that stop early (edge, obstacle) are cheap to restart;
+        // the cap only matters on a board with almost no room left
+        int starts = 0;
+        const int MAX_STARTS = 4 * count + 64;
+        while (placed < count && starts++ < MAX_STARTS) {
+            int cell = cellDist(rng);
+            if (board.at(cell) != Tile::Empty) continue;
+            int r = cell / board.cols(), c = cell % board.cols();
+            int dir = dirDist(rng);
+            int len = std::min(lenDist(rng), count - placed);
+            for (int i = 0; i < len; ++i) {
+                if (!board.inBounds(r, c) || board.get(r, c) != Tile::Empty) break;
+                board.set(r, c, tile);
+                ++placed;
+                if (turnChance > 0.0 && unit(rng) < turnChance)
+                    dir = (dir + (unit(rng) < 0.5 ? 1 : 3)) % 4;
+                r += DR[dir];
+                c += DC[dir];
+            }
+        }
+        return placed;
+    }
+
+    // Partial Fisher-Yates over the empty cells: the first `total` slots
+    // become a uniform sample without replacement, assigned to the tiles
+    // in order. One shuffle serves every tile type.
+    template <class BoardT>
+    int scatterMany(BoardT& board, std::initializer_list<std::pair<Tile, int>> want,
+                    std::mt19937& rng)
+    {
+        int total = 0;
+        for (const auto& w : want) total += std::max(0, w.second);
+        if (total == 0) return 0;
+
+        std::vector<int> empty;
+        empty.reserve(board.size());
+        for (int cell = 0; cell < board.size(); ++cell)
+            if (board.at(cell) == Tile::Empty) empty.push_back(cell);
+
+        const int last = static_cast<int>(empty.size()) - 1;
+        int i = 0;
+        for (const auto& [tile, count] : want) {
+            for (int k = 0; k < count && i <= last; ++k, ++i) {
+                std::uniform_int_distribution<int> pick(i, last);
+                std::swap(empty[i], empty[pick(rng)]);
+                board.setAt(empty[i], tile);
+            }
+        }
+        return i;
+    }
+}
+
+template <class BoardT>
+int TerrainGen::scatter(BoardT& board, Tile tile, int count, std::mt19937& rng)
+{
+    return scatterMany(board, {{tile, count}}, rng);
+}
+
+template <class BoardT>
+int TerrainGen::walls(BoardT& board, Tile tile, int count, std::mt19937& rng)
+{
+    return segments(board, tile, count, rng, 4, 12, 0.15);
+}
+
+template <class BoardT>
+int TerrainGen::corridors(BoardT& board, Tile tile, int count, std::mt19937& rng)
+{
+    int longest = std::max(board.rows(), board.cols()) / 2;
+    return segments(board, tile, count, rng, 5, std::max(5, longest), 0.0);
+}
+
+template <class BoardT>
+void TerrainGen::generate(BoardT& board, TerrainStyle style, const TerrainCounts& counts,
+                          std::mt19937& rng)
+{
+    int pits = counts.pits, flames = counts.flames, mounds = counts.mounds;
+    if (style == TerrainStyle::Walls)     mounds -= walls(board, Tile::Mound, mounds, rng);
+    if (style == TerrainStyle::Corridors) flames -= corridors(board, Tile::Flame, flames, rng);
+
+    scatterMany(board, {{Tile::Pit, pits}, {Tile::Flame, flames}, {Tile::Mound, mounds}}, rng);
+}
+
+template int TerrainGen::scatter(Board&, Tile, int, std::mt19937&);
+template int TerrainGen::walls(Board&, Tile, int, std::mt19937&);
+template int TerrainGen::corridors(Board&, Tile, int, std::mt19937&);
+template void TerrainGen::generate(Board&, TerrainStyle, const TerrainCounts&, std::mt19937&);
+
+template int TerrainGen::scatter(StandardBoard&, Tile, int, std::mt19937&);
+template int TerrainGen::walls(StandardBoard&, Tile, int, std::mt19937&);
+template int TerrainGen::corridors(StandardBoard&, Tile, int, std::mt19937&);
+template void TerrainGen::generate(StandardBoard&, TerrainStyle, const TerrainCounts&, std::mt19937&);
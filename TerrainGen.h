@@ -0,0 +1,32 @@
+//TerrainGen.h
+#pragma once
+#include <random>
+#include "Board.h"
+
+// Obstacle layouts. Scattered drops every obstacle on an independent
+// random cell (the original behaviour). Walls lays the mounds out as
+// clustered wall segments; Corridors lays the flames out as long straight
+// runs. Whatever a structured layout does not use is scattered.
+enum class TerrainStyle { Scattered, Walls, Corridors };
+
+struct TerrainCounts {
+    int pits = 0, flames = 0, mounds = 0;
+};
+
+namespace TerrainGen {
+    // Fills empty cells of `board` with the requested obstacles. Scattering
+    // is a partial Fisher-Yates shuffle over the flat array of empty cells,
+    // so it never retries and never places two obstacles on one cell; if
+    // the board runs out of empty cells the counts are truncated.
+    template <class BoardT>
+    void generate(BoardT& board, TerrainStyle style, const TerrainCounts& counts,
+                  std::mt19937& rng);
+
+    // Individual passes, each returning how many tiles it placed.
+    template <class BoardT>
+    int scatter(BoardT& board, Tile tile, int count, std::mt19937& rng);
+    template <class BoardT>
+    int walls(BoardT& board, Tile tile, int count, std::mt19937& rng);
+    template <class BoardT>
+    int corridors(BoardT& board, Tile tile, int count, std::mt19937& rng);
+}
@@ -0,0 +1,116 @@
+//ThreadPool.cpp
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    // Index of the pool worker running on this thread; callers from outside
+    // the pool have none and submit round-robin.
+    thread_local const ThreadPool* t_pool = nullptr;
+    thread_local unsigned t_worker = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i) m_queues.push_back(std::make_unique<Queue>());
+    m_workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    unsigned q = (t_pool == this) ? t_worker
+                                  : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+    {
+        std::lock_guard<std::mutex> lk(m_queues[q]->m);
+        m_queues[q]->tasks.push_back(std::move(task));
+    }
+    {
+        // taken so a worker between its empty check and its wait cannot miss this
+        std::lock_guard<std::mutex> lk(m_sleepMutex);
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+    m_wake.notify_one();
+}
+
+bool ThreadPool::popOwn(unsigned self, std::function<void()>& out) {
+    Queue& q = *m_queues[self];
+    std::lock_guard<std::mutex> lk(q.m);
+    if (q.tasks.empty()) return false;
+    out = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned self, std::function<void()>& out) {
+    for (unsigned k = 1; k < size(); ++k) {
+        Queue& q = *m_queues[(self + k) % size()];
+        std::lock_guard<std::mutex> lk(q.m);
+        if (q.tasks.empty()) continue;
+        out = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::runOne(unsigned self) {
+    std::function<void()> task;
+    if (!popOwn(self, task) && !steal(self, task)) return false;
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned self) {
+    t_pool = this;
+    t_worker = self;
+    for (;;) {
+        if (runOne(self)) continue;
+        std::unique_lock<std::mutex> lk(m_sleepMutex);
+        m_wake.wait(lk, [this] { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stop && m_queued.load() == 0) return;
+    }
+}
+
+void ThreadPool::parallelFor(size_t n, const std::function<void(size_t)>& fn, size_t grain) {
+    if (n == 0) return;
+    grain = std::max<size_t>(1, grain);
+    size_t chunks = (n + grain - 1) / grain;
+
+    // Chunks are claimed from a shared counter, so whichever thread is free
+    // takes the next one; the tasks below only recruit workers into that.
+    struct Shared {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex m;
+        std::condition_variable cv;
+    };
+    auto shared = std::make_shared<Shared>();
+    auto work = [shared, &fn, n, grain, chunks] {
+        for (;;) {
+            size_t k = shared->next.fetch_add(1, std::memory_order_relaxed);
+            if (k >= chunks) return;
+            size_t hi = std::min(n, (k + 1) * grain);
+            for (size_t i = k * grain; i < hi; ++i) fn(i);
+            if (shared->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                std::lock_guard<std::mutex> lk(shared->m);
+                shared->cv.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min<size_t>(chunks - 1, size());
+    for (size_t i = 0; i < helpers; ++i) submit(work);
+    work();
+
+    std::unique_lock<std::mutex> lk(shared->m);
+    shared->cv.wait(lk, [&] { return shared->done.load(std::memory_order_acquire) == chunks; });
+}
@@ -0,0 +1,54 @@
+//ThreadPool.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque. A worker runs
+// its own newest task first and, when it runs dry, steals the oldest task
+// from another worker, so uneven work (one robot's turn costing 100x
+// another's) spreads out without a central queue. Tasks must not throw.
+class ThreadPool {
+public:
+    // 0 = one worker per hardware thread
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // workers start while m_workers is still filling, so they read this instead
+    unsigned size() const { return static_cast<unsigned>(m_queues.size()); }
+
+    void submit(std::function<void()> task);
+
+    // Calls fn(i) for every i in [0, n), `grain` indices per task, and
+    // returns once all calls have finished. The calling thread works too,
+    // so this may be used from inside a task without deadlocking.
+    void parallelFor(size_t n, const std::function<void(size_t)>& fn, size_t grain = 1);
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(unsigned self);
+    bool runOne(unsigned self);             // own queue first, then steal
+    bool popOwn(unsigned self, std::function<void()>& out);
+    bool steal(unsigned self, std::function<void()>& out);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<unsigned> m_nextQueue{0};
+    std::atomic<size_t> m_queued{0};
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+};
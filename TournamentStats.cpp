@@ -0,0 +1,172 @@
+//TournamentStats.cpp
+#include "TournamentStats.h"
+#include "Arena.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+void RunningStat::add(double x) {
+    ++m_n;
+    double delta = x - m_mean;
+    m_mean += delta / m_n;
+    m_m2 += delta * (x - m_mean);
+}
+
+double RunningStat::stddev() const {
+    return (m_n > 1) ? std::sqrt(m_m2 / (m_n - 1)) : 0.0;
+}
+
+P2Quantile::P2Quantile(double p) : m_p(p) {
+    m_want[0] = 1; m_want[1] = 1 + 2 * p; m_want[2] = 1 + 4 * p; m_want[3] = 3 + 2 * p; m_want[4] = 5;
+    m_inc[0] = 0;  m_inc[1] = p / 2;      m_inc[2] = p;          m_inc[3] = (1 + p) / 2;  m_inc[4] = 1;
+}
+
+void P2Quantile::add(double x) {
+    if (m_n < 5) {
+        m_q[m_n++] = x;
+        if (m_n == 5) {
+            std::sort(m_q, m_q + 5);
+            for (int i = 0; i < 5; ++i) m_pos[i] = i + 1;
+        }
+        return;
+    }
+    ++m_n;
+
+    int k;
+    if (x < m_q[0])       { m_q[0] = x; k = 0; }
+    else if (x >= m_q[4]) { m_q[4] = x; k = 3; }
+    else { k = 0; while (k < 3 && x >= m_q[k + 1]) ++k; }
+
+    for (int i = k + 1; i < 5; ++i) m_pos[i] += 1;
+    for (int i = 0; i < 5; ++i) m_want[i] += m_inc[i];
+
+    for (int i = 1; i <= 3; ++i) {
+        double d = m_want[i] - m_pos[i];
+        if ((d >= 1 && m_pos[i + 1] - m_pos[i] > 1) || (d <= -1 && m_pos[i - 1] - m_pos[i] < -1)) {
+            int s = (d > 0) ? 1 : -1;
+            double qp = m_q[i] + s / (m_pos[i + 1] - m_pos[i - 1]) *
+                        ((m_pos[i] - m_pos[i - 1] + s) * (m_q[i + 1] - m_q[i]) / (m_pos[i + 1] - m_pos[i]) +
+                         (m_pos[i + 1] - m_pos[i] - s) * (m_q[i] - m_q[i - 1]) / (m_pos[i] - m_pos[i - 1]));
+            if (m_q[i - 1] < qp && qp < m_q[i + 1]) {
+                m_q[i] = qp;
+            } else {
+                m_q[i] += s * (m_q[i + s] - m_q[i]) / (m_pos[i + s] - m_pos[i]);
+            }
+            m_pos[i] += s;
+        }
+    }
+}
+
+double P2Quantile::value() const {
+    if (m_n == 0) return 0.0;
+    if (m_n < 5) {
+        double tmp[5];
+        std::copy(m_q, m_q + m_n, tmp);
+        std::sort(tmp, tmp + m_n);
+        return tmp[std::min(m_n - 1, (int)(m_p * m_n))];
+    }
+    return m_q[2];
+}
+
+void SurvivalCurve::add(int roundsAlive, bool died) {
+    size_t bin = 0;
+    while (bin < EDGES.size() && roundsAlive > EDGES[bin]) ++bin;
+    if (died) m_deaths[bin]++;
+    else      m_censored[bin]++;
+}
+
+std::array<double, SurvivalCurve::EDGES.size()> SurvivalCurve::curve() const {
+    long atRisk = 0;
+    for (size_t i = 0; i < m_deaths.size(); ++i) atRisk += m_deaths[i] + m_censored[i];
+
+    std::array<double, EDGES.size()> out{};
+    double s = 1.0;
+    for (size_t i = 0; i < EDGES.size(); ++i) {
+        if (atRisk > 0) s *= 1.0 - (double)m_deaths[i] / atRisk;
+        out[i] = s;
+        atRisk -= m_deaths[i] + m_censored[i];
+    }
+    return out;
+}
+
+std::string TournamentStats::typeOf(std::string_view name) {
+    size_t us = name.rfind('_');
+    return std::string(us == std::string_view::npos ? name : name.substr(0, us));
+}
+
+void TournamentStats::recordGame(std::span<const RobotEntry> robots, int rounds, bool stalemate) {
+    ++m_games;
+    m_gameRounds.add(rounds);
+    if (stalemate) ++m_stalemates;
+
+    int survivors = 0;
+    for (const auto& re : robots) {
+        if (re.alive && re.bot->get_health() > 0) ++survivors;
+    }
+    if (survivors == 0) ++m_noSurvivor;
+
+    for (const auto& re : robots) {
+        TypeStats& t = m_types[typeOf(re.name)];
+        bool survived = re.alive && re.bot->get_health() > 0;
+
+        t.entries++;
+        if (survived && !stalemate && survivors == 1) t.wins++;
+        if (survived && stalemate) t.coWins++;
+        t.kills      += re.kills;
+        t.deaths     += re.died ? 1 : 0;
+        t.shotsFired += re.shotsFired;
+        t.shotsLanded += re.shotsLanded;
+        t.damageDealt.add(re.damageDealt);
+        t.damageTaken.add(re.damageTaken);
+        t.roundsAlive.add(re.roundsAlive);
+        t.medianRoundsAlive.add(re.roundsAlive);
+        t.survival.add(re.roundsAlive, !survived);
+    }
+}
+
+void TournamentStats::printSummary(std::ostream& os) const {
+    auto flags = os.flags();
+    auto prec  = os.precision();
+    os << std::fixed << std::setprecision(2);
+
+    os << "\n=== Tournament Summary: " << m_games << " games ===\n";
+    os << "Avg rounds/game: " << m_gameRounds.mean()
+       << " (sd " << m_gameRounds.stddev() << ")"
+       << "  stalemates: " << m_stalemates
+       << "  no survivor: " << m_noSurvivor << "\n\n";
+
+    os << std::left << std::setw(12) << "Type" << std::right
+       << std::setw(8) << "Entries" << std::setw(8) << "Win%" << std::setw(8) << "CoWin%"
+       << std::setw(8) << "K/D" << std::setw(8) << "Acc%"
+       << std::setw(10) << "DmgOut" << std::setw(10) << "DmgIn"
+       << std::setw(10) << "Rounds" << std::setw(8) << "Median" << "\n";
+
+    for (const auto& [type, t] : m_types) {
+        double n = (double)t.entries;
+        os << std::left << std::setw(12) << type << std::right
+           << std::setw(8) << t.entries
+           << std::setw(8) << 100.0 * t.wins / n
+           << std::setw(8) << 100.0 * t.coWins / n;
+        if (t.deaths > 0) os << std::setw(8) << (double)t.kills / t.deaths;
+        else              os << std::setw(8) << "-";
+        if (t.shotsFired > 0) os << std::setw(8) << 100.0 * t.shotsLanded / t.shotsFired;
+        else                  os << std::setw(8) << "-";
+        os << std::setw(10) << t.damageDealt.mean()
+           << std::setw(10) << t.damageTaken.mean()
+           << std::setw(10) << t.roundsAlive.mean()
+           << std::setw(8)  << t.medianRoundsAlive.value() << "\n";
+    }
+
+    os << "\nSurvival (fraction alive after N rounds):\n";
+    os << std::left << std::setw(12) << "Type" << std::right;
+    for (int e : SurvivalCurve::EDGES) os << std::setw(7) << e;
+    os << "\n";
+    for (const auto& [type, t] : m_types) {
+        os << std::left << std::setw(12) << type << std::right;
+        for (double s : t.survival.curve()) os << std::setw(7) << s;
+        os << "\n";
+    }
+
+    os.flags(flags);
+    os.precision(prec);
+}
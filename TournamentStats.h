@@ -0,0 +1,87 @@
+//TournamentStats.h
+#pragma once
+#include <array>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <span>
+#include <vector>
+
+struct RobotEntry;
+
+// Running mean / variance (Welford). Constant memory, numerically stable.
+class RunningStat {
+public:
+    void add(double x);
+    long   count() const { return m_n; }
+    double mean()  const { return m_mean; }
+    double stddev() const;
+private:
+    long   m_n = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;
+};
+
+// P-square streaming quantile estimator (Jain & Chlamtac): five markers,
+// no sample storage.
+class P2Quantile {
+public:
+    explicit P2Quantile(double p = 0.5);
+    void add(double x);
+    double value() const;
+private:
+    double m_p;
+    int    m_n = 0;
+    double m_q[5]{};
+    double m_pos[5]{};
+    double m_want[5]{};
+    double m_inc[5]{};
+};
+
+// Binned Kaplan-Meier survival curve over rounds alive. Robots still alive
+// when their game ends are censored at that round.
+class SurvivalCurve {
+public:
+    static constexpr std::array<int, 10> EDGES = {10, 25, 50, 100, 200, 300, 500, 1000, 2000, 5000};
+    void add(int roundsAlive, bool died);
+    // estimated fraction of robots still alive after EDGES[k] rounds
+    std::array<double, EDGES.size()> curve() const;
+private:
+    std::array<long, EDGES.size() + 1> m_deaths{};
+    std::array<long, EDGES.size() + 1> m_censored{};
+};
+
+// Aggregates every robot's RobotEntry counters across all games of a run,
+// grouped by robot type (the name up to the last '_').
+class TournamentStats {
+public:
+    void recordGame(std::span<const RobotEntry> robots, int rounds, bool stalemate);
+    void printSummary(std::ostream& os) const;
+
+    long games() const { return m_games; }
+
+private:
+    struct TypeStats {
+        long entries = 0;
+        long wins = 0;          // sole survivor
+        long coWins = 0;        // survivor of a stalemate
+        long kills = 0;
+        long deaths = 0;
+        long shotsFired = 0;
+        long shotsLanded = 0;   // shots that hit at least one robot
+        RunningStat damageDealt;
+        RunningStat damageTaken;
+        RunningStat roundsAlive;
+        P2Quantile  medianRoundsAlive{0.5};
+        SurvivalCurve survival;
+    };
+
+    static std::string typeOf(std::string_view name);
+
+    std::map<std::string, TypeStats> m_types;
+    long m_games = 0;
+    long m_stalemates = 0;
+    long m_noSurvivor = 0;
+    RunningStat m_gameRounds;
+};
@@ -0,0 +1,147 @@
+//WorldState.cpp
+#include "WorldState.h"
+#include "AoE.h"
+#include "DamageModel.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    int sign(int v) { return (v > 0) - (v < 0); }
+}
+
+void WorldState::reset(int rows, int cols, uint64_t seed) {
+    m_rows = rows;
+    m_cols = cols;
+    m_rng = seed;
+    m_tiles.assign(static_cast<size_t>(rows) * cols, Tile::Empty);
+    m_occupancy.assign(static_cast<size_t>(rows) * cols, -1);
+    m_robots.clear();
+}
+
+int WorldState::addRobot(int r, int c, int health, int armor, int move, int grenades,
+                         WeaponType weapon, bool alive, bool trapped) {
+    SimRobot s;
+    s.r = static_cast<int16_t>(r);
+    s.c = static_cast<int16_t>(c);
+    s.health = static_cast<int16_t>(health);
+    s.armor = static_cast<int16_t>(armor);
+    s.move = static_cast<int16_t>(move);
+    s.grenades = static_cast<int16_t>(grenades);
+    s.weapon = static_cast<uint8_t>(weapon);
+    s.flags = (alive ? SimRobot::Alive : 0) | (trapped ? SimRobot::Trapped : 0);
+    m_robots.push_back(s);
+    int idx = static_cast<int>(m_robots.size()) - 1;
+    m_occupancy[r * m_cols + c] = idx;
+    return idx;
+}
+
+int WorldState::aliveCount() const {
+    return static_cast<int>(std::count_if(m_robots.begin(), m_robots.end(),
+                                          [](const SimRobot& s) { return s.alive(); }));
+}
+
+void WorldState::stepRound(std::span<const SimAction> actions) {
+    for (size_t i = 0; i < m_robots.size() && i < actions.size(); ++i) {
+        if (aliveCount() <= 1) break;
+        step(static_cast<int>(i), actions[i]);
+    }
+}
+
+void WorldState::step(int i, const SimAction& action) {
+    if (!m_robots[i].alive()) return;
+    if (action.kind == SimActionKind::Shot) shoot(i, action.a, action.b);
+    else if (action.kind == SimActionKind::Move) move(i, action.a, action.b);
+}
+
+// DM::applyArmorThenDegrade on the plain copy.
+void WorldState::damage(int i, int amount) {
+    SimRobot& s = m_robots[i];
+    int dealt = std::max(0, amount - s.armor);
+    s.health = static_cast<int16_t>(std::max(0, s.health - dealt));
+    if (s.armor > 0) --s.armor;
+    if (s.health == 0) s.flags &= ~SimRobot::Alive;
+}
+
+int WorldState::nextFlameDamage() {
+    uint64_t z = (m_rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return DM::FlameTileMin + static_cast<int>(z % (DM::FlameTileMax - DM::FlameTileMin + 1));
+}
+
+void WorldState::move(int i, int dir, int dist) {
+    SimRobot& s = m_robots[i];
+    if (s.trapped()) return;
+    if (dir < 1 || dir > 8 || dist <= 0) return;
+
+    dist = std::min<int>(dist, s.move);
+    const int dr = directions[dir].first, dc = directions[dir].second;
+    for (int step = 0; step < dist; ++step) {
+        int nr = s.r + dr, nc = s.c + dc;
+        if (!inBounds(nr, nc) || tile(nr, nc) == Tile::Mound) break;
+
+        int other = robotAt(nr, nc);
+        if (other >= 0) {
+            // a living robot means both take collision damage; a corpse just blocks
+            if (m_robots[other].alive()) {
+                damage(i, DM::CollisionDamage);
+                damage(other, DM::CollisionDamage);
+            }
+            break;
+        }
+
+        m_occupancy[s.r * m_cols + s.c] = -1;
+        m_occupancy[nr * m_cols + nc] = i;
+        s.r = static_cast<int16_t>(nr);
+        s.c = static_cast<int16_t>(nc);
+
+        Tile t = tile(nr, nc);
+        if (t == Tile::Pit) {
+            s.flags |= SimRobot::Trapped;
+            break;
+        }
+        if (t == Tile::Flame) {
+            damage(i, nextFlameDamage());
+            if (!s.alive()) break;
+        }
+    }
+}
+
+void WorldState::hitArea(const AoeShape& shape, int r0, int c0, int amount) {
+    thread_local std::vector<int> hits;
+    hits.clear();
+    AoE::gather(m_occupancy, m_rows, m_cols, shape, r0, c0, hits);
+    for (int idx : hits)
+        if (m_robots[idx].alive()) damage(idx, amount);
+}
+
+void WorldState::shoot(int i, int r, int c) {
+    const SimRobot s = m_robots[i];
+    const int dr = sign(r - s.r), dc = sign(c - s.c);
+
+    switch (static_cast<WeaponType>(s.weapon)) {
+        case railgun: {
+            if (!(s.r == r || s.c == c || std::abs(r - s.r) == std::abs(c - s.c))) return;
+            if (dr == 0 && dc == 0) return;
+            // pierces every living robot to the edge of the board
+            for (int rr = s.r + dr, cc = s.c + dc; inBounds(rr, cc); rr += dr, cc += dc) {
+                int idx = robotAt(rr, cc);
+                if (idx >= 0 && m_robots[idx].alive()) damage(idx, DM::RailgunDamage);
+            }
+            break;
+        }
+        case flamethrower:
+            if (dr == 0 && dc == 0) return;
+            hitArea(AoE::flameCone(dr, dc), s.r, s.c, DM::FlamethrowerDamage);
+            break;
+        case hammer:
+            hitArea(AoE::hammer(), s.r, s.c, DM::HammerDamage);
+            break;
+        case grenade: {
+            if (std::abs(r - s.r) + std::abs(c - s.c) > DM::GrenadeRange) return;
+            hitArea(AoE::grenadeBlast(), r, c, DM::GrenadeDamage);
+            break;
+        }
+    }
+}
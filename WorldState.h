@@ -0,0 +1,81 @@
+//WorldState.h
+#pragma once
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "Tile.h"
+#include "RobotBase.h"
+
+struct AoeShape;
+
+// Plain-data copy of a game in progress, for robots that search ahead
+// (rollouts, expectimax over moves). It holds no robot objects, only what
+// the rules read: tiles, and per robot its position, stats and flags.
+// Everything is trivially copyable, so copying a WorldState into one that
+// already has the capacity is a memcpy per array and no allocation;
+// keep a few scratch states around and assign into them.
+//
+// step() applies the arena's movement and weapon rules (applyMovement and
+// the resolve* functions): same ranges, armor and collision damage, and
+// the same AoE footprints. test_arena plays rounds both ways and checks
+// they agree. It keeps no statistics and prints nothing, and flame tile
+// damage comes from the state's own generator rather than the arena's.
+
+struct SimRobot {
+    enum : uint8_t { Alive = 1, Trapped = 2 };
+    int16_t r = 0, c = 0;
+    int16_t health = 0, armor = 0, move = 0, grenades = 0;
+    uint8_t weapon = 0;        // WeaponType
+    uint8_t flags = 0;
+
+    bool alive() const { return flags & Alive; }
+    bool trapped() const { return flags & Trapped; }
+};
+static_assert(std::is_trivially_copyable_v<SimRobot>);
+
+enum class SimActionKind : uint8_t { None, Shot, Move };
+
+struct SimAction {
+    SimActionKind kind = SimActionKind::None;
+    int a = 0, b = 0;          // shot row/col, or move direction/distance
+};
+
+class WorldState {
+public:
+    // Empty board; fill with setTile/addRobot, or take one from Arena::snapshotWorld.
+    void reset(int rows, int cols, uint64_t seed = 1);
+    int  addRobot(int r, int c, int health, int armor, int move, int grenades,
+                  WeaponType weapon, bool alive = true, bool trapped = false);
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    bool inBounds(int r, int c) const { return r >= 0 && c >= 0 && r < m_rows && c < m_cols; }
+    Tile tile(int r, int c) const { return m_tiles[r * m_cols + c]; }
+    void setTile(int r, int c, Tile t) { m_tiles[r * m_cols + c] = t; }
+    // Robot index at (r, c), corpses included, or -1.
+    int robotAt(int r, int c) const { return m_occupancy[r * m_cols + c]; }
+
+    std::span<const SimRobot> robots() const { return m_robots; }
+    const SimRobot& robot(int i) const { return m_robots[i]; }
+    int aliveCount() const;
+
+    // Plays robot i's action. Dead robots do nothing.
+    void step(int i, const SimAction& action);
+    // One sequential round: actions[i] for robot i, in roster order,
+    // stopping once one robot is left, like Arena::playRound.
+    void stepRound(std::span<const SimAction> actions);
+
+private:
+    void move(int i, int dir, int dist);
+    void shoot(int i, int r, int c);
+    void damage(int i, int amount);
+    void hitArea(const AoeShape& shape, int r0, int c0, int amount);
+    int  nextFlameDamage();
+
+    int m_rows = 0, m_cols = 0;
+    uint64_t m_rng = 1;
+    std::vector<Tile> m_tiles;         // rows*cols, row-major
+    std::vector<int> m_occupancy;      // cell -> robot index (corpses too), or -1
+    std::vector<SimRobot> m_robots;
+};
@@ -0,0 +1,48 @@
+//batch_env.cpp
+// Drives a BatchEnv with random actions and reports throughput; a starting
+// point for hooking up a training loop.
+//
+//   batch_env [games] [steps] [threads]
+#include "BatchEnv.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+int main(int argc, char** argv) {
+    BatchEnvOptions options;
+    int steps = 1000;
+    int threads = 1;
+    if (argc > 1) options.games = std::stoi(argv[1]);
+    if (argc > 2) steps = std::stoi(argv[2]);
+    if (argc > 3) threads = std::stoi(argv[3]);
+
+    std::unique_ptr<ThreadPool> pool;
+    if (threads != 1) pool = std::make_unique<ThreadPool>(static_cast<unsigned>(threads));
+    BatchEnv env(options, pool.get());
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dir(1, 8), kind(0, 2), cell(0, options.arena.rows - 1);
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        for (auto& a : env.actions()) {
+            a.radarDir = dir(rng);
+            a.kind = static_cast<SimActionKind>(kind(rng));
+            if (a.kind == SimActionKind::Shot) { a.a = cell(rng); a.b = cell(rng); }
+            else { a.a = dir(rng); a.b = 3; }
+        }
+        env.step();
+        for (float r : env.rewards()) total += r;
+    }
+    std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+
+    long gameSteps = static_cast<long>(steps) * env.games();
+    std::cout << env.games() << " games x " << steps << " steps in " << took.count() << "s: "
+              << static_cast<long>(gameSteps / took.count()) << " game steps/s, "
+              << env.episodes() << " episodes, mean reward/episode "
+              << (env.episodes() ? total / env.episodes() : 0.0) << "\n";
+    return 0;
+}
@@ -0,0 +1,501 @@
+//logagg.cpp
+// Native replacement for sumlog.py and stratlog.py.
+//
+// Memory-maps the Reaper logs and totals them with a chunked scan, one
+// chunk per thread. Prints the same report the Python scripts print, then
+// a percentile section on per-game values.
+//
+//   logagg [-j threads] [--summary reaper_only_stats.csv] [--brain reaper_stats.csv]
+//
+// With neither --summary nor --brain both default files are processed.
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// ---------- mapped input ----------
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) return;
+        struct stat st{};
+        if (::fstat(m_fd, &st) != 0) return;
+        m_size = static_cast<size_t>(st.st_size);
+        if (m_size == 0) { m_ok = true; return; }
+        void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (p == MAP_FAILED) return;
+        ::madvise(p, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(p);
+        m_ok = true;
+    }
+    ~MappedFile() {
+        if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+        if (m_fd >= 0) ::close(m_fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return m_ok; }
+    std::string_view view() const { return {m_data ? m_data : "", m_size}; }
+
+private:
+    int m_fd = -1;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_ok = false;
+};
+
+// Splits the text into at most n pieces that each start at a line start.
+std::vector<std::string_view> splitLines(std::string_view text, unsigned n) {
+    std::vector<std::string_view> out;
+    size_t begin = 0;
+    for (unsigned i = 1; i <= n && begin < text.size(); ++i) {
+        size_t end = (i == n) ? text.size() : text.size() / n * i;
+        if (end < begin) end = begin;
+        if (end < text.size()) {
+            size_t nl = text.find('\n', end);
+            end = (nl == std::string_view::npos) ? text.size() : nl + 1;
+        }
+        out.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return out;
+}
+
+template <typename Fn>
+void forEachLine(std::string_view chunk, Fn&& fn) {
+    size_t pos = 0;
+    while (pos < chunk.size()) {
+        size_t nl = chunk.find('\n', pos);
+        size_t end = (nl == std::string_view::npos) ? chunk.size() : nl;
+        fn(chunk.substr(pos, end - pos), pos);
+        pos = end + 1;
+    }
+}
+
+std::string_view strip(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))  s.remove_suffix(1);
+    return s;
+}
+
+// Same contract as Python's int(): optional sign, digits, surrounding blanks.
+bool parseInt(std::string_view s, long long& out) {
+    s = strip(s);
+    if (s.empty()) return false;
+    bool neg = false;
+    if (s.front() == '-' || s.front() == '+') { neg = s.front() == '-'; s.remove_prefix(1); }
+    if (s.empty()) return false;
+    long long v = 0;
+    for (char ch : s) {
+        if (ch < '0' || ch > '9') return false;
+        v = v * 10 + (ch - '0');
+    }
+    out = neg ? -v : v;
+    return true;
+}
+
+// Exact percentiles over integer samples with memory bounded by the number
+// of distinct values rather than the number of rows.
+class IntHistogram {
+public:
+    void add(long long v) { ++m_counts[v]; ++m_n; }
+    void merge(const IntHistogram& o) {
+        for (const auto& [v, n] : o.m_counts) m_counts[v] += n;
+        m_n += o.m_n;
+    }
+    long long count() const { return m_n; }
+    // nearest-rank percentile, p in [0,100]
+    long long percentile(double p) const {
+        if (m_n == 0) return 0;
+        long long rank = static_cast<long long>(p / 100.0 * m_n + 0.999999);
+        rank = std::clamp(rank, 1LL, m_n);
+        long long seen = 0;
+        for (const auto& [v, n] : m_counts) {
+            seen += n;
+            if (seen >= rank) return v;
+        }
+        return m_counts.rbegin()->first;
+    }
+private:
+    std::map<long long, long long> m_counts;
+    long long m_n = 0;
+};
+
+void printPercentileHeader() {
+    std::printf("%-22s %8s %8s %8s %8s %8s\n", "Per-game value", "p50", "p90", "p99", "max", "n");
+}
+
+void printPercentileRow(const char* label, const IntHistogram& h) {
+    std::printf("%-22s %8lld %8lld %8lld %8lld %8lld\n", label,
+                h.percentile(50), h.percentile(90), h.percentile(99),
+                h.percentile(100), h.count());
+}
+
+template <typename Partial>
+std::vector<Partial> scanParallel(std::string_view text, unsigned threads, const Partial& proto) {
+    auto chunks = splitLines(text, threads);
+    std::vector<Partial> parts(chunks.size(), proto);
+    std::vector<std::thread> pool;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        size_t base = static_cast<size_t>(chunks[i].data() - text.data());
+        pool.emplace_back([&, i, base] { parts[i].scan(chunks[i], base); });
+    }
+    for (auto& t : pool) t.join();
+    return parts;
+}
+
+// ---------- reaper_stats.csv ([SWEEPER-BRAIN-SUMMARY] lines, stratlog.py) ----------
+
+const char* const MODE_NAMES[]         = {"ESC", "EXP", "HUNT", "REPOS", "DRIFT"};
+const char* const ESCAPE_CAUSE_NAMES[] = {"close", "flame", "rail", "damage"};
+const char* const KNOWN_BUCKET_NAMES[] = {"low", "mid", "high"};
+constexpr std::string_view BRAIN_TAG = "[SWEEPER-BRAIN-SUMMARY]";
+
+struct BrainTotals {
+    long long games = 0;
+    long long moves[5] = {};
+    long long stays[5] = {};
+    long long dirs[9] = {};
+    long long escape[4] = {};
+    long long known[3] = {};
+    long long stuck = 0;
+    IntHistogram movesPerGame, staysPerGame, stuckPerGame;
+
+    void scan(std::string_view chunk, size_t) {
+        forEachLine(chunk, [&](std::string_view line, size_t) { parseLine(strip(line)); });
+    }
+
+    void merge(const BrainTotals& o) {
+        games += o.games;
+        for (int i = 0; i < 5; ++i) { moves[i] += o.moves[i]; stays[i] += o.stays[i]; }
+        for (int i = 0; i < 9; ++i) dirs[i] += o.dirs[i];
+        for (int i = 0; i < 4; ++i) escape[i] += o.escape[i];
+        for (int i = 0; i < 3; ++i) known[i] += o.known[i];
+        stuck += o.stuck;
+        movesPerGame.merge(o.movesPerGame);
+        staysPerGame.merge(o.staysPerGame);
+        stuckPerGame.merge(o.stuckPerGame);
+    }
+
+private:
+    // first whitespace token starting with prefix and holding '=', text after '='
+    static bool findValue(std::string_view line, std::string_view prefix, std::string_view& out) {
+        size_t pos = 0;
+        while (pos < line.size()) {
+            while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+            size_t end = pos;
+            while (end < line.size() && !std::isspace(static_cast<unsigned char>(line[end]))) ++end;
+            std::string_view tok = line.substr(pos, end - pos);
+            size_t eq = tok.find('=');
+            if (tok.substr(0, prefix.size()) == prefix && eq != std::string_view::npos) {
+                out = tok.substr(eq + 1);
+                return true;
+            }
+            pos = end;
+        }
+        return false;
+    }
+
+    static bool parseList(std::string_view s, long long* out, int n) {
+        for (int i = 0; i < n; ++i) {
+            size_t comma = s.find(',');
+            if (!parseInt(s.substr(0, comma), out[i])) return false;
+            if (comma == std::string_view::npos) return i == n - 1;
+            s.remove_prefix(comma + 1);
+        }
+        return true;
+    }
+
+    void parseLine(std::string_view line) {
+        if (line.substr(0, BRAIN_TAG.size()) != BRAIN_TAG) return;
+
+        std::string_view mv, st, dr, es, kn, sk;
+        if (!findValue(line, "movesByMode(", mv) || !findValue(line, "staysByMode(", st) ||
+            !findValue(line, "dirCounts(", dr)   || !findValue(line, "escapeCauses(", es) ||
+            !findValue(line, "knownBuckets(", kn) || !findValue(line, "timesStuck", sk)) {
+            return;
+        }
+
+        long long m[5], s[5], d[9], e[4], k[3], t;
+        if (!parseList(mv, m, 5) || !parseList(st, s, 5) || !parseList(dr, d, 9) ||
+            !parseList(es, e, 4) || !parseList(kn, k, 3) || !parseInt(sk, t)) {
+            return;
+        }
+
+        ++games;
+        long long gameMoves = 0, gameStays = 0;
+        for (int i = 0; i < 5; ++i) {
+            moves[i] += m[i]; stays[i] += s[i];
+            gameMoves += m[i]; gameStays += s[i];
+        }
+        for (int i = 0; i < 9; ++i) dirs[i] += d[i];
+        for (int i = 0; i < 4; ++i) escape[i] += e[i];
+        for (int i = 0; i < 3; ++i) known[i] += k[i];
+        stuck += t;
+        movesPerGame.add(gameMoves);
+        staysPerGame.add(gameStays);
+        stuckPerGame.add(t);
+    }
+};
+
+void reportBrain(const BrainTotals& b) {
+    std::printf("Parsed %lld brain-summary lines\n\n", b.games);
+
+    std::printf("Moves + stays by mode:\n");
+    for (int i = 0; i < 5; ++i)
+        std::printf("  %-6s  moves=%6lld  stays=%6lld\n", MODE_NAMES[i], b.moves[i], b.stays[i]);
+
+    long long movesSum = 0;
+    for (long long v : b.moves) movesSum += v;
+    if (movesSum > 0) {
+        std::printf("\nMove mode percentages (by moves only):\n");
+        for (int i = 0; i < 5; ++i)
+            std::printf("  %-6s  %6.2f%%\n", MODE_NAMES[i], 100.0 * b.moves[i] / movesSum);
+    }
+
+    std::printf("\nDirection choice counts (dir 0..8):\n");
+    for (int d = 0; d < 9; ++d) std::printf("  dir %d: %lld\n", d, b.dirs[d]);
+
+    long long dirSum = 0;
+    for (long long v : b.dirs) dirSum += v;
+    if (dirSum > 0) {
+        std::printf("\nDirection percentages (by chosen move dir):\n");
+        for (int d = 0; d < 9; ++d) std::printf("  dir %d: %6.2f%%\n", d, 100.0 * b.dirs[d] / dirSum);
+    }
+
+    std::printf("\nEscape causes (times ESCAPE was triggered by each condition):\n");
+    for (int i = 0; i < 4; ++i) std::printf("  %-6s: %lld\n", ESCAPE_CAUSE_NAMES[i], b.escape[i]);
+
+    std::printf("\nKnowledge bucket counts at decision time:\n");
+    for (int i = 0; i < 3; ++i) std::printf("  %-6s: %lld\n", KNOWN_BUCKET_NAMES[i], b.known[i]);
+
+    std::printf("\nTotal timesStuck across all games: %lld\n", b.stuck);
+
+    std::printf("\nPercentiles:\n");
+    printPercentileHeader();
+    printPercentileRow("moves / game", b.movesPerGame);
+    printPercentileRow("stays / game", b.staysPerGame);
+    printPercentileRow("timesStuck / game", b.stuckPerGame);
+}
+
+// ---------- reaper_only_stats.csv (Arena::writeReaperStats, sumlog.py) ----------
+
+enum SummaryCol { C_CAUSE, C_WON, C_KILLS, C_FIRED, C_HIT, C_DEALT, C_TAKEN, C_ROUNDS, C_STUCK, C_COUNT };
+const char* const SUMMARY_COL_NAMES[C_COUNT] = {
+    "causeOfDeath", "won", "kills", "shotsFired", "shotsHit",
+    "damageDealt", "damageTaken", "roundsSurvived", "timesStuck"
+};
+
+struct CauseCount {
+    long long count = 0;
+    size_t firstSeen = 0;   // byte offset, keeps Counter.most_common() tie order
+};
+
+struct SummaryTotals {
+    const int* colIndex = nullptr;   // header column of each SummaryCol, -1 if absent
+    long long rows = 0, deaths = 0;
+    long long sums[C_COUNT] = {};
+    std::unordered_map<std::string_view, CauseCount> causes;
+    IntHistogram kills, dealt, taken, rounds;
+
+    void scan(std::string_view chunk, size_t base) {
+        forEachLine(chunk, [&](std::string_view line, size_t off) { parseRow(line, base + off); });
+    }
+
+    void merge(const SummaryTotals& o) {
+        rows += o.rows;
+        deaths += o.deaths;
+        for (int i = 0; i < C_COUNT; ++i) sums[i] += o.sums[i];
+        for (const auto& [cause, cc] : o.causes) {
+            auto& mine = causes[cause];
+            if (mine.count == 0 || cc.firstSeen < mine.firstSeen) mine.firstSeen = cc.firstSeen;
+            mine.count += cc.count;
+        }
+        kills.merge(o.kills);
+        dealt.merge(o.dealt);
+        taken.merge(o.taken);
+        rounds.merge(o.rounds);
+    }
+
+private:
+    void parseRow(std::string_view line, size_t offset) {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) return;
+
+        std::string_view field[C_COUNT];
+        int col = 0;
+        size_t pos = 0;
+        while (true) {
+            size_t comma = line.find(',', pos);
+            std::string_view f = line.substr(pos, comma == std::string_view::npos ? comma : comma - pos);
+            for (int k = 0; k < C_COUNT; ++k)
+                if (colIndex[k] == col) field[k] = f;
+            if (comma == std::string_view::npos) break;
+            pos = comma + 1;
+            ++col;
+        }
+
+        ++rows;
+        long long v[C_COUNT] = {};
+        for (int k = C_WON; k < C_COUNT; ++k) {
+            if (!parseInt(field[k], v[k])) v[k] = 0;   // to_int()
+            sums[k] += v[k];
+        }
+        kills.add(v[C_KILLS]);
+        dealt.add(v[C_DEALT]);
+        taken.add(v[C_TAKEN]);
+        rounds.add(v[C_ROUNDS]);
+
+        if (field[C_CAUSE] != "alive") {
+            ++deaths;
+            auto& cc = causes[field[C_CAUSE]];
+            if (cc.count++ == 0) cc.firstSeen = offset;
+        }
+    }
+};
+
+void reportSummary(const SummaryTotals& s) {
+    long long wins = s.sums[C_WON], kills = s.sums[C_KILLS];
+    long long fired = s.sums[C_FIRED], hit = s.sums[C_HIT];
+
+    std::printf("Total runs (rows): %lld\n", s.rows);
+    std::printf("Total deaths     : %lld\n", s.deaths);
+    std::printf("Total wins       : %lld\n", wins);
+    std::printf("Total kills      : %lld\n\n", kills);
+
+    if (s.deaths > 0) std::printf("K/D ratio        : %.2f\n", (double)kills / s.deaths);
+    else              std::printf("K/D ratio        : N/A (no deaths)\n");
+
+    long long losses = s.rows - wins;
+    if (losses > 0)    std::printf("Win/Loss ratio   : %.2f\n", (double)wins / losses);
+    else if (wins > 0) std::printf("Win/Loss ratio   : ∞ (no losses)\n");
+    else               std::printf("Win/Loss ratio   : N/A\n");
+    double winRate = s.rows ? 100.0 * wins / s.rows : 0.0;
+    std::printf("Win rate         : %5.2f%%\n\n", winRate);
+
+    auto avg = [&](int k) { return s.rows ? (double)s.sums[k] / s.rows : 0.0; };
+    double accuracy = fired ? 100.0 * hit / fired : 0.0;
+    std::printf("Aggregate performance:\n");
+    std::printf("  Shot accuracy        : %5.2f%% (%lld / %lld)\n", accuracy, hit, fired);
+    std::printf("  Avg kills per run    : %5.2f\n", avg(C_KILLS));
+    std::printf("  Avg dmg dealt / run  : %7.2f\n", avg(C_DEALT));
+    std::printf("  Avg dmg taken / run  : %7.2f\n", avg(C_TAKEN));
+    std::printf("  Avg rounds survived  : %7.2f\n", avg(C_ROUNDS));
+    std::printf("  Avg times stuck / run: %7.2f\n\n", avg(C_STUCK));
+
+    std::vector<std::pair<std::string_view, CauseCount>> causes(s.causes.begin(), s.causes.end());
+    std::sort(causes.begin(), causes.end(), [](const auto& a, const auto& b) {
+        if (a.second.count != b.second.count) return a.second.count > b.second.count;
+        return a.second.firstSeen < b.second.firstSeen;
+    });
+    std::printf("Cause-of-death summary:\n");
+    std::printf("%-40s %8s %12s\n", "Cause of Death", "Count", "% of deaths");
+    for (const auto& [cause, cc] : causes) {
+        double pct = s.deaths ? 100.0 * cc.count / s.deaths : 0.0;
+        std::printf("%-40.*s %8lld %12.2f\n", (int)cause.size(), cause.data(), cc.count, pct);
+    }
+
+    std::printf("\nPercentiles:\n");
+    printPercentileHeader();
+    printPercentileRow("kills / run", s.kills);
+    printPercentileRow("dmg dealt / run", s.dealt);
+    printPercentileRow("dmg taken / run", s.taken);
+    printPercentileRow("rounds survived / run", s.rounds);
+}
+
+bool runBrain(const std::string& path, unsigned threads) {
+    MappedFile f(path);
+    if (!f.ok()) { std::cerr << "logagg: cannot read " << path << "\n"; return false; }
+    BrainTotals total;
+    auto parts = scanParallel(f.view(), threads, total);
+    for (const auto& p : parts) total.merge(p);
+    reportBrain(total);
+    return true;
+}
+
+bool runSummary(const std::string& path, unsigned threads) {
+    MappedFile f(path);
+    if (!f.ok()) { std::cerr << "logagg: cannot read " << path << "\n"; return false; }
+
+    std::string_view text = f.view();
+    size_t nl = text.find('\n');
+    std::string_view header = text.substr(0, nl);
+    if (!header.empty() && header.back() == '\r') header.remove_suffix(1);
+    std::string_view body = (nl == std::string_view::npos) ? std::string_view{} : text.substr(nl + 1);
+
+    int colIndex[C_COUNT];
+    std::fill(std::begin(colIndex), std::end(colIndex), -1);
+    int col = 0;
+    size_t pos = 0;
+    while (true) {
+        size_t comma = header.find(',', pos);
+        std::string_view name = header.substr(pos, comma == std::string_view::npos ? comma : comma - pos);
+        for (int k = 0; k < C_COUNT; ++k)
+            if (name == SUMMARY_COL_NAMES[k]) colIndex[k] = col;
+        if (comma == std::string_view::npos) break;
+        pos = comma + 1;
+        ++col;
+    }
+    for (int k = 0; k < C_COUNT; ++k) {
+        if (colIndex[k] < 0) {
+            std::cerr << "logagg: " << path << " has no '" << SUMMARY_COL_NAMES[k] << "' column\n";
+            return false;
+        }
+    }
+
+    SummaryTotals total;
+    total.colIndex = colIndex;
+    auto parts = scanParallel(body, threads, total);
+    for (const auto& p : parts) total.merge(p);
+    reportSummary(total);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string summaryPath, brainPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-j" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1, std::stoi(argv[++i])));
+        } else if (a == "--summary" && i + 1 < argc) {
+            summaryPath = argv[++i];
+        } else if (a == "--brain" && i + 1 < argc) {
+            brainPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [-j threads] [--summary reaper_only_stats.csv] [--brain reaper_stats.csv]\n";
+            return 1;
+        }
+    }
+    if (summaryPath.empty() && brainPath.empty()) {
+        summaryPath = "reaper_only_stats.csv";
+        brainPath   = "reaper_stats.csv";
+    }
+
+    bool ok = true;
+    if (!summaryPath.empty()) ok = runSummary(summaryPath, threads) && ok;
+    if (!summaryPath.empty() && !brainPath.empty()) std::printf("\n");
+    if (!brainPath.empty()) ok = runBrain(brainPath, threads) && ok;
+    return ok ? 0 : 1;
+}
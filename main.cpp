@@ -1,5 +1,16 @@
 #include "Arena.h"
 #include "RobotBase.h"
+#include "TournamentStats.h"
+#include "Replay.h"
+#include "LiveViewer.h"
+#include "Config.h"
+#include "ThreadPool.h"
+#include "RobotPool.h"
+#include "SandboxedRobot.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -10,6 +21,7 @@ extern "C" RobotBase* create_robot_hammer();    //hammer bot
 extern "C" RobotBase* create_robot_grenadier(); //grenadier bot
 extern "C" RobotBase* create_robot_sniper();    //sniper bot
 extern "C" RobotBase* create_robot_cornersniper();    //corner sniper bot
+extern "C" RobotBase* create_robot_planner();           //planner bot (anytime)
 //extern "C" RobotBase* create_robot_tune();      //tune?
 //extern "C" RobotBase* create_robot_bob();       //bob
 
@@ -20,38 +32,156 @@ struct RobotSpec {
     int          count;      
 };
 
-int main(int argc, char** argv) {
-    int numGames=1;
-    if (argc > 1) {
-        numGames = std::stoi(argv[1]);
-    }
-    const int rows = 20;
-    const int cols = 20;
-
-    for (int i = 0; i < numGames; ++i) {
-        Arena arena(rows, cols);
-
-        std::vector<RobotSpec> specs = {
-            { create_robot,          "Reaper",   'S', 1  },
-            { create_robot_flame,    "Flame",    'R', 7 },
-            { create_robot_rat,      "Rat",      'R', 4 },
-            { create_robot_hammer,   "Hammer",   'R', 3 },
-            { create_robot_grenadier,"Grenadier",'R', 3 },
-            { create_robot_sniper,   "Sniper",   'R', 5 },
-            { create_robot_cornersniper,"Corner",'C', 1 },
-//            { create_robot_tune,     "Tune",     'T', 1 },
-//            { create_robot_bob,      "Bob",      'B', 1 },
-        };
+// Robot types a config roster line can name.
+static RobotFactory factoryFor(const std::string& type) {
+    static const std::map<std::string, RobotFactory> registry = {
+        { "Reaper",    create_robot },
+        { "Flame",     create_robot_flame },
+        { "Rat",       create_robot_rat },
+        { "Hammer",    create_robot_hammer },
+        { "Grenadier", create_robot_grenadier },
+        { "Sniper",    create_robot_sniper },
+        { "Corner",    create_robot_cornersniper },
+        { "Planner",   create_robot_planner },
+    };
+    auto it = registry.find(type);
+    return it == registry.end() ? nullptr : it->second;
+}
+
+// Plays every configured game on one arena of the given board type.
+template <class BoardT>
+static void playGames(const Config& cfg, const std::vector<RobotSpec>& specs, RobotPool& robots,
+                      TournamentStats& stats, LiveViewer* viewer, ThreadPool* pool) {
+    ArenaT<BoardT> arena(cfg.arena);
+    arena.setRobotPool(&robots);
+    arena.setTournamentStats(&stats);
+    arena.setOutputMode(cfg.output);
+    arena.setViewer(viewer);
+    arena.setThreadPool(pool);
+    std::vector<RobotSpawn> roster;
+    for (int i = 0; i < cfg.games; ++i) {
+        // reproducible, but not the same game N times
+        if (i > 0) arena.reset(cfg.arena.seed ? cfg.arena.seed + i : 0);
+        std::unique_ptr<ReplayWriter> replay;
+        if (!cfg.replayPrefix.empty())
+            replay = std::make_unique<ReplayWriter>(cfg.replayPrefix + "_" + std::to_string(i+1) + ".rwr");
+        arena.setReplayWriter(replay.get());
 
+        roster.clear();
         for (const auto& spec : specs) {
             for (int i = 0; i < spec.count; ++i) {
-                RobotBase* bot = spec.factory();
+                RobotBase* bot = robots.acquire(spec.factory, cfg.sandbox ? SandboxedRobot::create : nullptr);
                 std::string name = spec.baseName + "_" + std::to_string(i+1);
-                arena.addRobotRandom(bot, name, spec.symbol);
+                roster.push_back({ bot, name, spec.symbol });
             }
         }
-            arena.run(20);
+        arena.addRobotsRandom(roster);
+        arena.run();
+        arena.setReplayWriter(nullptr);
+        if (cfg.memoryReport) {
+            GameMemory m = arena.gameMemory();
+            std::cout << "Game memory: " << m.allocations << " allocations, "
+                      << (m.bytes + 1023) / 1024 << " KiB requested; "
+                      << (m.heapBytes + 1023) / 1024 << " KiB from the heap in "
+                      << m.heapBlocks << " blocks\n";
         }
-    return 0;
+    }
+}
+
+// A whole number of at least 1, as the game count and --fps take.
+static bool readCount(const std::string& value, int& out) {
+    try {
+        size_t used = 0;
+        int n = std::stoi(value, &used);
+        if (used != value.size() || n < 1) return false;
+        out = n;
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
 }
 
+int main(int argc, char** argv) {
+    // RobotWarz [numGames] [--config file] [--live [--fps N] | --headless] [--replay prefix] [--sandbox]
+    // Command-line flags override the config file.
+    Config cfg;
+    for (int a = 1; a + 1 < argc; ++a) {
+        if (std::string(argv[a]) == "--config") {
+            std::string error;
+            if (!loadConfig(argv[a + 1], cfg, error)) {
+                std::cerr << error << "\n";
+                return 1;
+            }
+        }
+    }
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg == "--config" && a + 1 < argc) {
+            ++a;
+        } else if (arg == "--live") {
+            cfg.output = OutputMode::Live;
+        } else if (arg == "--headless") {
+            cfg.output = OutputMode::Headless;
+        } else if (arg == "--fps" && a + 1 < argc && readCount(argv[a + 1], cfg.fps)) {
+            ++a;
+        } else if (arg == "--replay" && a + 1 < argc) {
+            cfg.replayPrefix = argv[++a];
+        } else if (arg == "--sandbox") {
+            cfg.sandbox = true;
+        } else if (!readCount(arg, cfg.games)) {
+            std::cerr << "Usage: " << argv[0] << " [numGames] [--config file] [--live [--fps N] | --headless]"
+                      << " [--replay prefix] [--sandbox]\n";
+            return 1;
+        }
+    }
+
+    std::vector<RobotSpec> specs = {
+        { create_robot,          "Reaper",   'S', 1  },
+        { create_robot_flame,    "Flame",    'R', 7 },
+        { create_robot_rat,      "Rat",      'R', 4 },
+        { create_robot_hammer,   "Hammer",   'R', 3 },
+        { create_robot_grenadier,"Grenadier",'R', 3 },
+        { create_robot_sniper,   "Sniper",   'R', 5 },
+        { create_robot_cornersniper,"Corner",'C', 1 },
+//            { create_robot_tune,     "Tune",     'T', 1 },
+//            { create_robot_bob,      "Bob",      'B', 1 },
+    };
+    if (!cfg.roster.empty()) {
+        specs.clear();
+        for (const auto& r : cfg.roster) {
+            RobotFactory f = factoryFor(r.type);
+            if (!f) {
+                std::cerr << "Unknown robot type '" << r.type << "' in config\n";
+                return 1;
+            }
+            specs.push_back({ f, r.type, r.symbol, r.count });
+        }
+    }
+
+    // Reapers share their learned weights and RNG through statics, so two of
+    // them can't decide on different threads (sandboxed, each has its own).
+    int reapers = 0;
+    for (const auto& spec : specs)
+        if (spec.factory == create_robot) reapers += spec.count;
+    if (reapers > 1 && cfg.threads != 1 && !cfg.sandbox) {
+        std::cerr << "Warning: " << reapers << " Reapers share state, running with threads = 1\n";
+        cfg.threads = 1;
+    }
+
+    TournamentStats stats;
+    std::unique_ptr<LiveViewer> viewer;
+    if (cfg.output == OutputMode::Live) viewer = std::make_unique<LiveViewer>(cfg.fps);
+    std::unique_ptr<ThreadPool> pool;
+    if (cfg.threads != 1) pool = std::make_unique<ThreadPool>(static_cast<unsigned>(cfg.threads));
+    if (cfg.sandbox) SandboxedRobot::setTimeout(std::chrono::milliseconds(cfg.sandboxTimeoutMs));
+    // One arena and one set of robots serve every game: between games the
+    // arena is reset and the robots are reset through the pool. The usual
+    // 20x20 board gets the arena with its size compiled in.
+    RobotPool robots;
+    if (StandardBoard::fits(cfg.arena.rows, cfg.arena.cols))
+        playGames<StandardBoard>(cfg, specs, robots, stats, viewer.get(), pool.get());
+    else
+        playGames<Board>(cfg, specs, robots, stats, viewer.get(), pool.get());
+    stats.printSummary(std::cout);
+    return 0;
+}
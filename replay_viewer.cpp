@@ -0,0 +1,83 @@
+//replay_viewer.cpp
+// Reconstructs rounds of a recorded game without re-simulating it.
+//
+//   replay_viewer game.rwr              summary of the recording
+//   replay_viewer game.rwr ROUND        board, robots and turns of ROUND
+//   replay_viewer game.rwr FROM TO      every round in [FROM, TO]
+#include "Replay.h"
+#include <iostream>
+#include <string>
+
+namespace {
+    const char* weaponName(int w) {
+        switch (w) {
+            case 0: return "flamethrower";
+            case 1: return "railgun";
+            case 2: return "grenade";
+            case 3: return "hammer";
+        }
+        return "unknown";
+    }
+
+    void printRound(const ReplayReader& rp) {
+        const ReplayState& st = rp.state();
+        std::cout << "\n=== Round " << st.round << " ===\n";
+        for (const auto& a : rp.actions()) {
+            const auto& rb = st.robots[a.robot];
+            std::cout << "Robot " << rb.name << rb.glyph << rb.idGlyph
+                      << " radar=" << a.radarDir;
+            switch (a.kind) {
+                case ReplayActionKind::Shot:
+                    std::cout << " shoots at (" << a.a << "," << a.b << ")\n"; break;
+                case ReplayActionKind::Move:
+                    std::cout << " moves: dir=" << a.a << " dist=" << a.b << "\n"; break;
+                default:
+                    std::cout << " does nothing.\n"; break;
+            }
+        }
+        st.printBoard(std::cout);
+        for (const auto& rb : st.robots) {
+            std::cout << "[" << rb.glyph << rb.idGlyph << "] " << rb.name << ": "
+                      << "  H: " << rb.health
+                      << "  W: " << weaponName(rb.weapon)
+                      << "  A: " << rb.armor
+                      << "  M: " << rb.move
+                      << "  at: (" << rb.r << "," << rb.c << ") "
+                      << (rb.alive ? "" : "  [DEAD]")
+                      << (rb.trapped ? "  [PIT]" : "") << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " <replay.rwr> [round | from to]\n";
+        return 1;
+    }
+
+    ReplayReader rp;
+    if (!rp.open(argv[1])) {
+        std::cerr << "replay_viewer: " << rp.error() << "\n";
+        return 1;
+    }
+
+    if (argc == 2) {
+        std::cout << argv[1] << ": " << rp.rows() << "x" << rp.cols() << " board, "
+                  << rp.state().robots.size() << " robots, "
+                  << rp.lastRound() << " rounds"
+                  << (rp.stalemate() ? " (stalemate)" : "")
+                  << ", keyframe every " << rp.keyframeInterval() << " rounds\n";
+        return 0;
+    }
+
+    int from = std::stoi(argv[2]);
+    int to   = (argc == 4) ? std::stoi(argv[3]) : from;
+    for (int round = from; round <= to && round <= rp.lastRound(); ++round) {
+        if (!rp.seek(round)) {
+            std::cerr << "replay_viewer: " << rp.error() << "\n";
+            return 1;
+        }
+        printRound(rp);
+    }
+    return 0;
+}
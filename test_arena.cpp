@@ -0,0 +1,149 @@
+//test_arena.cpp
+// Checks that WorldState plays by the arena's rules. Scripted robots play
+// rounds in a real arena; before each round the game is copied with
+// snapshotWorld, the same actions are stepped on the copy with stepRound,
+// and afterwards every robot's position, health, armor and flags must
+// match. Exits 1 on the first mismatch in any game.
+//
+//   test_arena [games] [rounds]
+//
+// Flame tiles roll their damage from different generators in the two
+// (see WorldState.h), so these boards have none.
+#include "Arena.h"
+#include "WorldState.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Plays whatever the test put in its action slot.
+    class ScriptedRobot : public RobotBase {
+    public:
+        ScriptedRobot(int move, int armor, WeaponType weapon, const SimAction* action)
+            : RobotBase(move, armor, weapon), m_action(action) {}
+
+        void get_radar_direction(int& dir) override { dir = 1; }
+        void process_radar_results(const std::vector<RadarObj>&) override {}
+
+        bool get_shot_location(int& r, int& c) override {
+            if (m_action->kind != SimActionKind::Shot) return false;
+            r = m_action->a;
+            c = m_action->b;
+            return true;
+        }
+
+        void get_move_direction(int& dir, int& dist) override {
+            dir = dist = 0;
+            if (m_action->kind != SimActionKind::Move) return;
+            dir = m_action->a;
+            dist = m_action->b;
+        }
+
+    private:
+        const SimAction* m_action;
+    };
+
+    struct Loadout { int move, armor; WeaponType weapon; char glyph; };
+    const Loadout ROSTER[] = {
+        { 3, 4, railgun,      'R' }, { 2, 5, flamethrower, 'F' },
+        { 4, 2, hammer,       'H' }, { 3, 3, grenade,      'G' },
+        { 5, 2, railgun,      'R' }, { 2, 4, hammer,       'H' },
+        { 4, 3, flamethrower, 'F' }, { 2, 5, grenade,      'G' },
+    };
+    constexpr size_t ROSTER_SIZE = sizeof(ROSTER) / sizeof(ROSTER[0]);
+
+    // Mostly shots at (or next to) other robots and moves that may run into
+    // them, walls, pits and corpses; now and then a wild shot or nothing.
+    void pickActions(const WorldState& world, std::mt19937& rng, std::vector<SimAction>& actions) {
+        std::uniform_int_distribution<int> pct(0, 99), dir(1, 8), dist(1, 6), jitter(-1, 1);
+        std::uniform_int_distribution<int> other(0, static_cast<int>(world.robots().size()) - 1);
+        std::uniform_int_distribution<int> row(0, world.rows() - 1), col(0, world.cols() - 1);
+        for (auto& a : actions) {
+            a = {};
+            int roll = pct(rng);
+            if (roll < 45) {
+                const SimRobot& t = world.robot(other(rng));
+                a = { SimActionKind::Shot, t.r + jitter(rng), t.c + jitter(rng) };
+            } else if (roll < 55) {
+                a = { SimActionKind::Shot, row(rng), col(rng) };
+            } else if (roll < 95) {
+                a = { SimActionKind::Move, dir(rng), dist(rng) };
+            }
+        }
+    }
+
+    bool same(const SimRobot& a, const SimRobot& b) {
+        return a.r == b.r && a.c == b.c && a.health == b.health && a.armor == b.armor && a.flags == b.flags;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const SimRobot& s) {
+        return os << "(" << s.r << "," << s.c << ") health " << s.health << " armor " << s.armor
+                  << (s.alive() ? "" : " dead") << (s.trapped() ? " trapped" : "");
+    }
+
+    bool readCount(const char* arg, int& out) {
+        try {
+            size_t used = 0;
+            out = std::stoi(arg, &used);
+            return arg[used] == '\0' && out >= 1;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int games = 200, rounds = 100;
+    if (argc > 3 || (argc > 1 && !readCount(argv[1], games)) || (argc > 2 && !readCount(argv[2], rounds))) {
+        std::cerr << "Usage: " << argv[0] << " [games] [rounds]\n";
+        return 1;
+    }
+
+    long compared = 0;
+    for (int g = 0; g < games; ++g) {
+        ArenaOptions options;
+        options.rows = options.cols = 12;
+        options.seed = static_cast<uint64_t>(g) + 1;
+        options.flames = { 0, 0 };
+        Arena arena(options);
+        arena.setOutputMode(OutputMode::Silent);
+
+        std::vector<SimAction> actions(ROSTER_SIZE);
+        std::vector<RobotSpawn> roster;
+        for (size_t k = 0; k < ROSTER_SIZE; ++k) {
+            const Loadout& l = ROSTER[k];
+            roster.push_back({ new ScriptedRobot(l.move, l.armor, l.weapon, &actions[k]),
+                               "Bot_" + std::to_string(k + 1), l.glyph });
+        }
+        // robot i of the arena must be the one reading actions[i]
+        if (arena.addRobotsRandom(roster) != ROSTER_SIZE) continue;
+        arena.startGame();
+
+        std::mt19937 rng(static_cast<std::mt19937::result_type>(g));
+        WorldState expected, actual;
+        for (int round = 1; round <= rounds; ++round) {
+            arena.snapshotWorld(expected);
+            if (expected.aliveCount() <= 1) break;
+            pickActions(expected, rng, actions);
+
+            bool more = arena.playRound();
+            expected.stepRound(actions);
+            arena.snapshotWorld(actual);
+            ++compared;
+
+            for (size_t i = 0; i < ROSTER_SIZE; ++i) {
+                if (same(expected.robot(static_cast<int>(i)), actual.robot(static_cast<int>(i)))) continue;
+                std::cerr << "game " << g + 1 << " round " << round << ": robot " << i + 1
+                          << " is " << actual.robot(static_cast<int>(i)) << " in the arena but "
+                          << expected.robot(static_cast<int>(i)) << " in WorldState\n";
+                return 1;
+            }
+            if (!more) break;
+        }
+        arena.finishGame();
+    }
+
+    std::cout << compared << " rounds in " << games << " games: WorldState matches the arena\n";
+    return 0;
+}
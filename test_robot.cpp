@@ -1,15 +1,67 @@
 #include "RobotBase.h"
+#include "Replay.h"
 #include <iostream>
+#include <iomanip>
 #include <vector>
 #include <dlfcn.h>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+
+// Usage:
+//   test_robot Robot_X.cpp                 the 10-turn smoke test below
+//   test_robot Robot_X.cpp --bench [opts]  time every robot call over many turns
+//
+// Options (all optional):
+//   --turns N         turns to play (default 100000)
+//   --rows R --cols C synthetic board size (default 20x20)
+//   --density PCT     percent of synthetic cells holding terrain (default 10)
+//   --enemies N       other robots wandering the synthetic board (default 6)
+//   --seed S          synthetic world seed (default 1)
+//   --replay F.rwr    recorded world instead: the robot stands where robot
+//   --as K            K of the recording (default 0) stood each round, and
+//                     its radar sees that round's board; rounds loop
+//   --factory NAME    the robot's extern "C" create function (default create_robot)
+
+// Counts every allocation made in this process. Robot libraries resolve
+// operator new to these, so the benchmark sees the robot's allocations too.
+namespace alloc_count {
+    size_t calls = 0;
+    size_t bytes = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++alloc_count::calls;
+    alloc_count::bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++alloc_count::calls;
+    alloc_count::bytes += size;
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return ::operator new(size, tag); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
 
-RobotBase* load_robot(const std::string& shared_lib, void* &handle) 
+RobotBase* load_robot(const std::string& shared_lib, void* &handle, const std::string& factory = "create_robot") 
 {
     std::cout << "Testing robot from " << shared_lib << "...\n";
 
     // Dynamically load the shared library
-    handle = dlopen(shared_lib.c_str(), RTLD_LAZY);
+    // a bare name would be searched for on the library path, not here
+    const std::string path = shared_lib.find('/') == std::string::npos ? "./" + shared_lib : shared_lib;
+    handle = dlopen(path.c_str(), RTLD_LAZY);
     if (!handle) 
     {
         std::cerr << "Failed to load " << shared_lib << ": " << dlerror() << '\n';
@@ -18,10 +70,10 @@ RobotBase* load_robot(const std::string& shared_lib, void* &handle)
 
     // Locate the create function to create the robot and 'assign' the function to this 'create_robot' function.
     // RobotFactory is a function pointer type 'typedef'ed in RobotBase.h
-    RobotFactory create_robot = (RobotFactory)dlsym(handle, "create_robot");
+    RobotFactory create_robot = (RobotFactory)dlsym(handle, factory.c_str());
     if (!create_robot) 
     {
-        std::cerr << "Failed to find create_robot in " << shared_lib << ": " << dlerror() << '\n';
+        std::cerr << "Failed to find " << factory << " in " << shared_lib << ": " << dlerror() << '\n';
         dlclose(handle);
         return nullptr;
     }
@@ -141,13 +193,347 @@ void test_robot_behavior(RobotBase* robot)
 
 
 
+// ---------------------------------------------------------------- benchmark
+
+struct BenchOptions {
+    long turns = 100000;
+    int rows = 20, cols = 20;
+    int density = 10;              // percent of cells with terrain
+    int enemies = 6;
+    uint64_t seed = 1;
+    std::string replay;            // empty = synthetic world
+    int as = 0;
+    std::string factory = "create_robot";
+};
+
+// The world the robot under test plays in: terrain and other robots, with
+// the radar cast like the arena's (every non-floor cell on the ray, robots
+// before the terrain under them, nearest first).
+struct BenchWorld {
+    int rows = 0, cols = 0;
+    std::vector<char> terrain;     // '.', 'M', 'P' or 'F' per cell
+    std::vector<char> bodies;      // robot glyph per cell, 'X' for a corpse, 0 for none
+    int row = 0, col = 0;          // the robot under test
+
+    void resize(int r, int c)
+    {
+        rows = r;
+        cols = c;
+        terrain.assign(static_cast<size_t>(r) * c, '.');
+        bodies.assign(terrain.size(), 0);
+    }
+    size_t index(int r, int c) const { return static_cast<size_t>(r) * cols + c; }
+    bool inBounds(int r, int c) const { return r >= 0 && c >= 0 && r < rows && c < cols; }
+    bool blocked(int r, int c) const
+    {
+        size_t i = index(r, c);
+        return terrain[i] == 'M' || terrain[i] == 'P' || bodies[i] != 0;
+    }
+
+    void scan(int dir, std::vector<RadarObj>& out) const
+    {
+        out.clear();
+        if (dir < 1 || dir > 8) return;
+        int dr = directions[dir].first, dc = directions[dir].second;
+        for (int r = row + dr, c = col + dc; inBounds(r, c); r += dr, c += dc) {
+            size_t i = index(r, c);
+            if (bodies[i]) out.emplace_back(bodies[i], r, c);
+            if (terrain[i] != '.') out.emplace_back(terrain[i], r, c);
+        }
+    }
+};
+
+// Random terrain and robots that wander a cell at a time. The robot under
+// test moves as it asks to, stopping short of mounds, pits and robots.
+class SyntheticStream {
+public:
+    explicit SyntheticStream(const BenchOptions& o) : m_rng(o.seed)
+    {
+        m_world.resize(o.rows, o.cols);
+        std::uniform_int_distribution<int> pct(0, 99), kind(0, 2);
+        const char glyphs[] = { 'M', 'P', 'F' };
+        for (char& t : m_world.terrain)
+            if (pct(m_rng) < o.density) t = glyphs[kind(m_rng)];
+        for (int i = 0; i < o.enemies; ++i) {
+            int r, c;
+            if (!freeCell(r, c)) break;
+            m_enemies.push_back({ r, c });
+            m_world.bodies[m_world.index(r, c)] = 'R';
+        }
+        if (!freeCell(m_world.row, m_world.col)) m_world.row = m_world.col = 0;
+    }
+
+    BenchWorld& world() { return m_world; }
+
+    void place(RobotBase* robot)
+    {
+        robot->set_boundaries(m_world.rows, m_world.cols);
+        robot->move_to(m_world.row, m_world.col);
+    }
+
+    void nextTurn(RobotBase*)
+    {
+        // up to MOVERS robots a turn, taking turns, so crowded boards stay cheap to run
+        std::uniform_int_distribution<int> dir(1, 8);
+        const size_t movers = std::min(m_enemies.size(), MOVERS);
+        for (size_t k = 0; k < movers; ++k) {
+            auto& [r, c] = m_enemies[m_nextMover];
+            m_nextMover = (m_nextMover + 1) % m_enemies.size();
+            int d = dir(m_rng);
+            int nr = r + directions[d].first, nc = c + directions[d].second;
+            if (!m_world.inBounds(nr, nc) || m_world.blocked(nr, nc) || (nr == m_world.row && nc == m_world.col))
+                continue;
+            m_world.bodies[m_world.index(r, c)] = 0;
+            m_world.bodies[m_world.index(nr, nc)] = 'R';
+            r = nr;
+            c = nc;
+        }
+    }
+
+    void move(RobotBase* robot, int dir, int dist)
+    {
+        if (dir < 1 || dir > 8) return;
+        for (int k = 0; k < dist; ++k) {
+            int nr = m_world.row + directions[dir].first, nc = m_world.col + directions[dir].second;
+            if (!m_world.inBounds(nr, nc) || m_world.blocked(nr, nc)) break;
+            m_world.row = nr;
+            m_world.col = nc;
+        }
+        robot->move_to(m_world.row, m_world.col);
+    }
+
+private:
+    bool freeCell(int& r, int& c)
+    {
+        std::uniform_int_distribution<int> rr(0, m_world.rows - 1), cc(0, m_world.cols - 1);
+        for (int tries = 0; tries < 1000; ++tries) {
+            r = rr(m_rng);
+            c = cc(m_rng);
+            if (!m_world.blocked(r, c) && m_world.terrain[m_world.index(r, c)] == '.') return true;
+        }
+        return false;
+    }
+
+    static constexpr size_t MOVERS = 64;
+
+    std::mt19937_64 m_rng;
+    BenchWorld m_world;
+    std::vector<std::pair<int, int>> m_enemies;
+    size_t m_nextMover = 0;
+};
+
+// A recorded game, one round per turn: the robot under test is put where
+// robot `as` stood, whatever it asked for, and sees that round's board.
+class ReplayStream {
+public:
+    bool open(const BenchOptions& o, std::string& error)
+    {
+        if (!m_reader.open(o.replay)) {
+            error = m_reader.error();
+            return false;
+        }
+        if (m_reader.lastRound() < 1 || o.as < 0 || o.as >= static_cast<int>(m_reader.state().robots.size())) {
+            error = "no such robot, or no rounds";
+            return false;
+        }
+        m_as = o.as;
+        m_world.resize(m_reader.rows(), m_reader.cols());
+        load(1);
+        return true;
+    }
+
+    BenchWorld& world() { return m_world; }
+    int rounds() const { return m_reader.lastRound(); }
+
+    void place(RobotBase* robot)
+    {
+        robot->set_boundaries(m_world.rows, m_world.cols);
+        robot->move_to(m_world.row, m_world.col);
+    }
+
+    void nextTurn(RobotBase* robot)
+    {
+        m_round = m_round % m_reader.lastRound() + 1;
+        load(m_round);
+        robot->move_to(m_world.row, m_world.col);
+    }
+
+    void move(RobotBase*, int, int) {}
+
+private:
+    void load(int round)
+    {
+        m_reader.seek(round);
+        const ReplayState& st = m_reader.state();
+        for (size_t i = 0; i < st.tiles.size(); ++i) m_world.terrain[i] = tileGlyph(st.tiles[i]);
+        std::fill(m_world.bodies.begin(), m_world.bodies.end(), 0);
+        for (size_t i = 0; i < st.robots.size(); ++i) {
+            const ReplayRobot& rb = st.robots[i];
+            if (static_cast<int>(i) == m_as) continue;
+            m_world.bodies[m_world.index(rb.r, rb.c)] = rb.alive ? rb.glyph : 'X';
+        }
+        m_world.row = st.robots[m_as].r;
+        m_world.col = st.robots[m_as].c;
+    }
+
+    ReplayReader m_reader;
+    BenchWorld m_world;
+    int m_as = 0;
+    int m_round = 1;
+};
+
+// Latency of every call to one robot method, and what it allocated.
+struct MethodTimes {
+    MethodTimes(const char* method) : name(method) {}
+    const char* name;
+    std::vector<uint32_t> ns;
+    size_t allocs = 0, bytes = 0, maxAllocs = 0;
+};
+
+template <class Call>
+auto timed(MethodTimes& m, Call&& call)
+{
+    using clock = std::chrono::steady_clock;
+    const size_t calls0 = alloc_count::calls, bytes0 = alloc_count::bytes;
+    const auto t0 = clock::now();
+    auto result = call();
+    const auto t1 = clock::now();
+    const size_t calls = alloc_count::calls - calls0;
+    m.allocs += calls;
+    m.bytes += alloc_count::bytes - bytes0;
+    m.maxAllocs = std::max(m.maxAllocs, calls);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    m.ns.push_back(static_cast<uint32_t>(std::min<int64_t>(ns, UINT32_MAX)));
+    return result;
+}
+
+void report(std::vector<MethodTimes>& methods)
+{
+    std::cout << std::left << std::setw(24) << "method" << std::right
+              << std::setw(10) << "calls" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns"
+              << std::setw(12) << "max ns" << std::setw(13) << "allocs/call" << std::setw(12) << "bytes/call"
+              << std::setw(12) << "max allocs" << "\n";
+    for (MethodTimes& m : methods) {
+        std::cout << std::left << std::setw(24) << m.name << std::right << std::setw(10) << m.ns.size();
+        if (m.ns.empty()) {
+            std::cout << "\n";
+            continue;
+        }
+        std::sort(m.ns.begin(), m.ns.end());
+        const size_t n = m.ns.size();
+        std::cout << std::setw(10) << m.ns[n / 2]
+                  << std::setw(10) << m.ns[std::min(n - 1, n * 99 / 100)]
+                  << std::setw(12) << m.ns.back()
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(13) << static_cast<double>(m.allocs) / n
+                  << std::setw(12) << static_cast<double>(m.bytes) / n
+                  << std::setw(12) << m.maxAllocs << "\n";
+    }
+}
+
+// Plays opts.turns turns in the order the arena makes its calls (the move
+// is only asked for when there is no shot) and times each call.
+template <class Stream>
+void run_benchmark(RobotBase* robot, Stream& stream, const BenchOptions& opts)
+{
+    stream.place(robot);
+    std::vector<MethodTimes> methods = {
+        { "get_radar_direction" }, { "process_radar_results" },
+        { "get_shot_location" }, { "get_move_direction" },
+    };
+    for (MethodTimes& m : methods) m.ns.reserve(opts.turns);
+
+    std::vector<RadarObj> radar_results;
+    radar_results.reserve(static_cast<size_t>(std::max(stream.world().rows, stream.world().cols)) * 2);
+
+    // what an empty timed call costs, included in every figure below
+    MethodTimes overhead{ "timer" };
+    overhead.ns.reserve(1000);
+    for (int i = 0; i < 1000; ++i) timed(overhead, [] { return 0; });
+    std::sort(overhead.ns.begin(), overhead.ns.end());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (long turn = 0; turn < opts.turns; ++turn) {
+        if (turn > 0) stream.nextTurn(robot);
+
+        int radar_direction = 0;
+        timed(methods[0], [&] { robot->get_radar_direction(radar_direction); return 0; });
+        stream.world().scan(radar_direction, radar_results);
+        timed(methods[1], [&] { robot->process_radar_results(radar_results); return 0; });
+
+        int shot_row = 0, shot_col = 0;
+        if (timed(methods[2], [&] { return robot->get_shot_location(shot_row, shot_col); }))
+            continue;
+        int move_direction = 0, move_distance = 0;
+        timed(methods[3], [&] { robot->get_move_direction(move_direction, move_distance); return 0; });
+        if (move_direction != 0 && move_distance > 0)
+            stream.move(robot, move_direction, std::min(move_distance, robot->get_move_speed()));
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n" << opts.turns << " turns in " << std::fixed << std::setprecision(2) << seconds
+              << " s (timer overhead ~" << overhead.ns[overhead.ns.size() / 2] << " ns per call, included)\n\n";
+    report(methods);
+}
+
+int benchmark_robot(RobotBase* robot, const BenchOptions& opts)
+{
+    if (!opts.replay.empty()) {
+        ReplayStream stream;
+        std::string error;
+        if (!stream.open(opts, error)) {
+            std::cerr << "Failed to read " << opts.replay << ": " << error << '\n';
+            return 1;
+        }
+        std::cout << "\nBenchmarking " << robot->m_name << ": recorded game " << opts.replay << " (" << stream.world().rows << "x" << stream.world().cols
+                  << ", " << stream.rounds() << " rounds, as robot " << opts.as << ")\n";
+        run_benchmark(robot, stream, opts);
+    } else {
+        SyntheticStream stream(opts);
+        std::cout << "\nBenchmarking " << robot->m_name << ": synthetic " << opts.rows << "x" << opts.cols << " board, " << opts.density
+                  << "% terrain, " << opts.enemies << " robots, seed " << opts.seed << "\n";
+        run_benchmark(robot, stream, opts);
+    }
+    return 0;
+}
+
+// Reads the options after the robot file; false on anything it doesn't know.
+bool parse_bench_options(int argc, char* argv[], bool& bench, BenchOptions& opts)
+{
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench") { bench = true; continue; }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        try {
+            if      (arg == "--turns")   opts.turns = std::stol(value);
+            else if (arg == "--rows")    opts.rows = std::stoi(value);
+            else if (arg == "--cols")    opts.cols = std::stoi(value);
+            else if (arg == "--density") opts.density = std::stoi(value);
+            else if (arg == "--enemies") opts.enemies = std::stoi(value);
+            else if (arg == "--seed")    opts.seed = std::stoull(value);
+            else if (arg == "--replay")  opts.replay = value;
+            else if (arg == "--as")      opts.as = std::stoi(value);
+            else if (arg == "--factory") opts.factory = value;
+            else return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return opts.turns >= 1 && opts.rows >= 1 && opts.cols >= 1 && opts.density >= 0 && opts.density <= 100
+        && opts.enemies >= 0;
+}
+
 int main(int argc, char* argv[]) 
 {
     //argv[1] should contain the name of the Robot_.cpp file to load.
 
-    if (argc != 2) 
+    bool bench = false;
+    BenchOptions opts;
+    if (argc < 2 || !parse_bench_options(argc, argv, bench, opts)) 
     {
-        std::cerr << "Usage: " << argv[0] << " <robot_library>\n";
+        std::cerr << "Usage: " << argv[0] << " <robot_library> [--bench] [--turns N] [--rows R] [--cols C]"
+                  << " [--density PCT] [--enemies N] [--seed S] [--replay FILE.rwr] [--as K] [--factory NAME]\n";
         return 1;
     }
 
@@ -157,6 +543,7 @@ int main(int argc, char* argv[])
     // Compile the robot into a shared library -fPIC is Position Independant Code - look it up!
     // we're also linking a pre-compiled RobotBase.o - problems will arise if there is a mismatch...
     std::string compile_cmd = "g++ -shared -fPIC -o " + shared_lib + " " + robot_file + " RobotBase.o -I. -std=c++20";
+    if (bench) compile_cmd += " -O2";   // time what the tournament build runs
     std::cout << "Compiling " << robot_file << " into " << shared_lib << "...\n";
 
     if (std::system(compile_cmd.c_str()) != 0) {
@@ -169,8 +556,11 @@ int main(int argc, char* argv[])
     RobotBase *robot;
     void *handle;
 
-    robot = load_robot(shared_lib, handle);
-    test_robot_behavior(robot);
+    robot = load_robot(shared_lib, handle, opts.factory);
+    if (!robot) return 1;
+    int status = 0;
+    if (bench) status = benchmark_robot(robot, opts);
+    else test_robot_behavior(robot);
 
     // Cleanup
     delete robot;
@@ -178,5 +568,5 @@ int main(int argc, char* argv[])
 
     std::cout << "Robot testing complete.\n";
 
-    return 0;
+    return status;
 }